@@ -102,8 +102,8 @@ using Motate::OutputPin;
 
 /**** Stepper DDA and dwell timer settings ****/
 
-//#define FREQUENCY_DDA		200000UL		// Hz step frequency. Interrupts actually fire at 2x (400 KHz)
-#define FREQUENCY_DDA		150000UL		// Hz step frequency. Interrupts actually fire at 2x (300 KHz)
+//#define FREQUENCY_DDA		200000UL		// Hz step frequency. One interrupt per step tick (see stepper.h)
+#define FREQUENCY_DDA		150000UL		// Hz step frequency. One interrupt per step tick (see stepper.h)
 #define FREQUENCY_DWELL		1000UL
 #define FREQUENCY_SGI		200000UL		// 200,000 Hz means software interrupts will fire 5 uSec after being called
 
@@ -357,7 +357,7 @@ void cm_set_model_linenum(int32_t linenum)
  */
 
 stat_t cm_check_linenum() {
-    if (cm->gmx.last_line_number != cm->gm.linenum) {
+    if ((cm->gmx.last_line_number+1) != cm->gm.linenum) {
         debug_trap("line number out of sequence");
         return STAT_LINE_NUMBER_OUT_OF_SEQUENCE;
     }
@@ -1136,8 +1136,70 @@ stat_t cm_resume_g92_offsets()
  ****************************************************************************************/
 /*
  * cm_straight_traverse() - G0 linear rapid
+ * _traverse_uncoordinated() - queue the leading sub-moves of an uncoordinated rapid
+ *
+ *  A coordinated G0 runs the whole line at the speed of its slowest axis, so the other
+ *  axes of a long diagonal rapid run below their velocity max. With {tru:1} the rapid is
+ *  split at the times each axis would finish moving at its own velocity max. In each
+ *  sub-move every axis still moving runs at its own velocity max, and the sub-moves are
+ *  blended through the normal junction planning, with the corners cut by each axis that
+ *  drops out. Every sub-move ends inside the box between the start and the target, so a
+ *  rapid that passes the soft limit test on its target stays within the soft limits.
+ *
+ *  Sub-moves shorter than MIN_BLOCK_TIME are merged into the next one. A rapid never takes
+ *  more than PLANNER_BUFFER_HEADROOM blocks, or more than the planner has free.
  */
 
+static stat_t _traverse_uncoordinated()
+{
+    float start[AXES];
+    float final[AXES];
+    float axis_time[AXES];
+    float total_time = 0;
+
+    copy_vector(start, cm->gmx.position);
+    copy_vector(final, cm->gm.target);
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        axis_time[axis] = 0;
+        if (fp_NOT_ZERO(final[axis] - start[axis])) {
+            if (fp_ZERO(cm->a[axis].velocity_max)) {
+                return (STAT_OK);                           // can't time it - run it coordinated
+            }
+            axis_time[axis] = fabs(final[axis] - start[axis]) / cm->a[axis].velocity_max;
+            total_time = max(total_time, axis_time[axis]);
+        }
+    }
+    stat_t status = STAT_OK;
+    float split_time = 0;
+    uint8_t max_blocks = min(PLANNER_BUFFER_HEADROOM, mp_get_planner_buffers(mp));
+    for (uint8_t blocks = 1; blocks < max_blocks; blocks++) {
+        float next_time = total_time;                       // earliest axis to finish after split_time
+        for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+            if (axis_time[axis] > (split_time + MIN_BLOCK_TIME)) {
+                next_time = min(next_time, axis_time[axis]);
+            }
+        }
+        if (next_time > (total_time - MIN_BLOCK_TIME)) {
+            break;                                          // the last sub-move is the rapid itself
+        }
+        split_time = next_time;
+        for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+            if (axis_time[axis] <= split_time) {
+                cm->gm.target[axis] = final[axis];
+            } else {
+                cm->gm.target[axis] = start[axis] + copysignf(cm->a[axis].velocity_max * split_time, final[axis] - start[axis]);
+            }
+        }
+        status = mp_aline(&cm->gm);
+        if ((status != STAT_OK) && (status != STAT_MINIMUM_LENGTH_MOVE)) {
+            break;
+        }
+        status = STAT_OK;
+    }
+    copy_vector(cm->gm.target, final);
+    return (status);
+}
+
 stat_t cm_straight_traverse(const float *target, const bool *flags, const uint8_t motion_profile)
 {
     cm->gm.motion_mode = MOTION_MODE_STRAIGHT_TRAVERSE;
@@ -1152,6 +1214,9 @@ stat_t cm_straight_traverse(const float *target, const bool *flags, const uint8_
     ritorno (cm_test_soft_limits(cm->gm.target));   // test soft limits; exit if thrown
     cm_set_display_offsets(&cm->gm);                // capture the fully resolved offsets to the state
     cm_cycle_start();                               // required here for homing & other cycles
+    if (cm->traverse_uncoordinated) {
+        ritorno(_traverse_uncoordinated());         // queue all but the last sub-move
+    }
     stat_t status = mp_aline(&cm->gm);              // send the move to the planner
     cm_update_model_position();                     // update gmx.position to ready for next incoming move
 
@@ -1324,6 +1389,95 @@ stat_t cm_straight_feed(const float *target, const bool *flags, const uint8_t mo
     return (status);
 }
 
+/****************************************************************************************
+ * cm_spindle_sync_feed() - G33 spindle synchronized motion
+ *
+ *  G33 feeds to the target with the axes locked to spindle rotation at K units of Z
+ *  travel per revolution (or K along the path if Z doesn't move). The move starts on
+ *  a spindle index pulse so repeated passes cut the same thread.
+ *
+ *  The move is planned at the pitch times the programmed S. The runtime then times
+ *  each segment against the measured spindle - see _spindle_sync_segment_time() in
+ *  plan_exec.cpp. Feed rate mode and F do not apply, and a feedhold abandons the thread.
+ *
+ *  The axes still accelerate and decelerate at the ends of the move, and there they
+ *  travel less than K per revolution. The pitch is only right in the body, so G33 must
+ *  start with a lead-in and end with a lead-out outside the finished thread.
+ *
+ *  G33.1 (rigid tapping) is rejected by the gcode parser. An index-only sensor can't see
+ *  the spindle slow down or reverse, so the tap can't be kept in step through the reversal.
+ */
+
+static stat_t _spindle_sync_move(const float pitch)
+{
+    cm->gm.spindle_sync_pitch = pitch;
+    mp_input_wait(gpio_get_spindle_index_input(), INPUT_WAIT_SPINDLE_INDEX, SPINDLE_INDEX_TIMEOUT_MS / 1000);
+    cm_set_display_offsets(&cm->gm);                // capture the fully resolved offsets to the state
+    stat_t status = mp_aline(&cm->gm);              // send the move to the planner
+    cm_update_model_position();
+    cm->gm.spindle_sync_pitch = 0;
+    return ((status == STAT_MINIMUM_LENGTH_MOVE) ? STAT_OK : status);
+}
+
+stat_t cm_spindle_sync_feed(const float target[], const bool flags[],
+                            const float K_word, const bool K_flag)
+{
+    if (!K_flag) {
+        return (STAT_K_WORD_IS_MISSING);
+    }
+    if (K_word <= 0) {
+        return (STAT_K_WORD_IS_INVALID);
+    }
+    if (fp_ZERO(cm->gmx.spindle_speed)) {
+        return (STAT_SPINDLE_MUST_BE_TURNING);
+    }
+    if (gpio_get_spindle_index_input() == 0) {
+        return (STAT_SPINDLE_INDEX_NOT_FOUND);
+    }
+    cm->gm.motion_mode = MOTION_MODE_SPINDLE_SYNC;
+
+    // it's legal for a G33 to have no axis words but we don't want to process it
+    if (!(flags[AXIS_X] | flags[AXIS_Y] | flags[AXIS_Z] |
+          flags[AXIS_U] | flags[AXIS_V] | flags[AXIS_W] |
+          flags[AXIS_A] | flags[AXIS_B] | flags[AXIS_C])) {
+        return(STAT_OK);
+    }
+
+    float start[AXES];
+    copy_vector(start, cm->gmx.position);
+    cm_set_model_target(target, flags);
+    ritorno (cm_test_soft_limits(cm->gm.target));   // test soft limits; exit if thrown
+
+    float length = get_axis_vector_length(cm->gm.target, start);
+    if (fp_ZERO(length)) {
+        return (STAT_OK);
+    }
+    float pitch = _to_millimeters(K_word);
+    float z_travel = fabs(cm->gm.target[AXIS_Z] - start[AXIS_Z]);
+    if (!fp_ZERO(z_travel)) {
+        pitch *= length / z_travel;                 // convert Z pitch to path pitch
+    }
+    float feed_rate = pitch * cm->gmx.spindle_speed;
+
+    // the axes can't be allowed to fall behind the spindle, so the planner mustn't clamp the feed
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        if ((feed_rate * fabs(cm->gm.target[axis] - start[axis]) / length) > cm->a[axis].feedrate_max) {
+            return (STAT_REQUESTED_VELOCITY_EXCEEDS_LIMITS);
+        }
+    }
+
+    float saved_feed_rate = cm->gm.feed_rate;
+    cmFeedRateMode saved_feed_rate_mode = cm->gm.feed_rate_mode;
+    cm->gm.feed_rate = feed_rate;
+    cm->gm.feed_rate_mode = UNITS_PER_MINUTE_MODE;
+    cm_cycle_start();                               // required for homing & other cycles
+
+    stat_t status = _spindle_sync_move(pitch);
+    cm->gm.feed_rate = saved_feed_rate;
+    cm->gm.feed_rate_mode = saved_feed_rate_mode;
+    return (status);
+}
+
 /****************************************************************************************
  **** Spindle Functions (4.3.7) *********************************************************
  ****************************************************************************************/
@@ -1690,6 +1844,29 @@ stat_t cm_json_wait(char *json_string)
     return mp_json_wait(json_string);
 }
 
+/*
+ * cm_wait_on_input() - M66 P<input> L<mode> Q<timeout seconds>
+ *
+ *  Modes are 0 immediate, 1 rise, 2 fall, 3 high, 4 low. A missing or zero Q waits
+ *  forever. The result is reported when the wait completes - see mp_input_wait().
+ */
+stat_t cm_wait_on_input(const float P_word, const bool P_flag, const uint8_t L_word, const float Q_word)
+{
+    if (!P_flag) {
+        return (STAT_P_WORD_IS_MISSING);
+    }
+    if ((P_word < 1) || (P_word > D_IN_CHANNELS) || fp_NOT_ZERO(P_word - (uint8_t)P_word)) {
+        return (STAT_P_WORD_IS_INVALID);
+    }
+    if (L_word > INPUT_WAIT_MODE_MAX) {
+        return (STAT_L_WORD_IS_INVALID);
+    }
+    if (Q_word < 0) {
+        return (STAT_Q_WORD_IS_INVALID);
+    }
+    return (mp_input_wait((uint8_t)P_word, (inputWaitMode)L_word, Q_word));
+}
+
 /****************************************************************************************
  * cm_run_home() - run homing sequence
  */
@@ -1949,7 +2126,12 @@ static const char msg_g01[] = "G1  - linear feed";
 static const char msg_g02[] = "G2  - clockwise arc feed";
 static const char msg_g03[] = "G3  - counter clockwise arc feed";
 static const char msg_g80[] = "G80 - cancel motion mode (none active)";
-static const char *const msg_momo[] = { msg_g00, msg_g01, msg_g02, msg_g03, msg_g80 };
+static const char msg_g382[] = "G38.2 - straight probe";
+static const char msg_g8x[] = "G81-G89 - canned cycle";
+static const char msg_g33[] = "G33 - spindle synchronized motion";
+static const char *const msg_momo[] = { msg_g00, msg_g01, msg_g02, msg_g03, msg_g80, msg_g382,
+                                        msg_g8x, msg_g8x, msg_g8x, msg_g8x, msg_g8x, msg_g8x, msg_g8x, msg_g8x, msg_g8x,
+                                        msg_g33 };
 
 static const char msg_g17[] = "G17 - XY plane";
 static const char msg_g18[] = "G18 - XZ plane";
@@ -2154,15 +2336,25 @@ void _cm_recalc_junction_accel(const uint8_t axis) {
     cm->a[axis].high_junction_accel = _junction_accel_multiplier * T2 * (cm->a[axis].jerk_high * JERK_MULTIPLIER);
 }
 
+// Recalculate all axes. Called once after a bulk config load, which skips the per-setter recalcs
+void cm_recalc_junction_accel()
+{
+    for (uint8_t axis=0; axis<AXES; axis++) {
+        _cm_recalc_junction_accel(axis);
+    }
+}
+
 void cm_set_axis_max_jerk(const uint8_t axis, const float jerk)
 {
     cm->a[axis].jerk_max = jerk;
+    if (nv_bulk_load) { return; }       // recalculated once at the end of the load
     _cm_recalc_junction_accel(axis);    // Must recalculate the max_junction_accel now that the jerk has changed.
 }
 
 void cm_set_axis_high_jerk(const uint8_t axis, const float jerk)
 {
     cm->a[axis].jerk_high = jerk;
+    if (nv_bulk_load) { return; }       // recalculated once at the end of the load
     _cm_recalc_junction_accel(axis);    // Must recalculate the max_junction_accel now that the jerk has changed.
 }
 
@@ -2259,6 +2451,8 @@ stat_t cm_set_zb(nvObj_t *nv) { return (set_float(nv, cm->a[_axis(nv)].zero_back
  * cm_set_ct()  - set chordal tolerance
  * cm_get_sl()  - get soft limit enable
  * cm_set_sl()  - set soft limit enable
+ * cm_get_tru() - get uncoordinated traverse enable
+ * cm_set_tru() - set uncoordinated traverse enable
  * cm_get_lim() - get hard limit enable
  * cm_set_lim() - set hard limit enable
  * cm_get_saf() - get safety interlock enable
@@ -2271,8 +2465,8 @@ stat_t cm_get_jt(nvObj_t *nv) { return(get_float(nv, cm->junction_integration_ti
 stat_t cm_set_jt(nvObj_t *nv)
 {
     ritorno(set_float_range(nv, cm->junction_integration_time, JUNCTION_INTEGRATION_MIN, JUNCTION_INTEGRATION_MAX));
-    for (uint8_t axis=0; axis<AXES; axis++) { // recalculate max_junction_accel now that time quanta has changed.
-        _cm_recalc_junction_accel(axis);
+    if (!nv_bulk_load) {
+        cm_recalc_junction_accel();     // recalculate max_junction_accel now that time quanta has changed.
     }
     return(STAT_OK);
 }
@@ -2286,6 +2480,9 @@ stat_t cm_set_zl(nvObj_t *nv) { return(set_float(nv, cm->feedhold_z_lift)); }
 stat_t cm_get_sl(nvObj_t *nv) { return(get_integer(nv, cm->soft_limit_enable)); }
 stat_t cm_set_sl(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->soft_limit_enable, 0, 1)); }
 
+stat_t cm_get_tru(nvObj_t *nv) { return(get_integer(nv, cm->traverse_uncoordinated)); }
+stat_t cm_set_tru(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->traverse_uncoordinated, 0, 1)); }
+
 stat_t cm_get_lim(nvObj_t *nv) { return(get_integer(nv, cm->limit_enable)); }
 stat_t cm_set_lim(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->limit_enable, 0, 1)); }
 
@@ -2417,14 +2614,32 @@ void cm_print_gdi(nvObj_t *nv) { text_print(nv, fmt_gdi);}  // TYPE_INT
 static const char fmt_jt[] = "[jt]  junction integration time%7.2f\n";
 static const char fmt_ct[] = "[ct]  chordal tolerance%17.4f%s\n";
 static const char fmt_zl[] = "[zl]  Z lift on feedhold%16.3f%s\n";
+static const char fmt_tsz[] ="[tsz] tool setter reference Z%11.3f%s\n";
+static const char fmt_tsf[] ="[tsf] tool setter fast feed%13.3f%s/min\n";
+static const char fmt_tss[] ="[tss] tool setter slow feed%13.3f%s/min\n";
+static const char fmt_tsb[] ="[tsb] tool setter backoff%15.3f%s\n";
+static const char fmt_prlf[]="[prlf] probe latch feed%16.3f%s/min [0=single pass]\n";
+static const char fmt_prlb[]="[prlb] probe latch backoff%13.3f%s\n";
+static const char fmt_prln[]="[prln] probe latch samples%9d\n";
+static const char fmt_prlt[]="[prlt] probe sample tolerance%10.3f%s [0=keep all]\n";
 static const char fmt_sl[] = "[sl]  soft limit enable%12d [0=disable,1=enable]\n";
+static const char fmt_tru[] ="[tru] uncoordinated traverse%7d [0=disable,1=enable]\n";
 static const char fmt_lim[] ="[lim] limit switch enable%10d [0=disable,1=enable]\n";
 static const char fmt_saf[] ="[saf] safety interlock enable%6d [0=disable,1=enable]\n";
 
 void cm_print_jt(nvObj_t *nv) { text_print(nv, fmt_jt);}        // TYPE FLOAT
 void cm_print_ct(nvObj_t *nv) { text_print_flt_units(nv, fmt_ct, GET_UNITS(ACTIVE_MODEL));}
 void cm_print_zl(nvObj_t *nv) { text_print_flt_units(nv, fmt_zl, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_tsz(nvObj_t *nv){ text_print_flt_units(nv, fmt_tsz, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_tsf(nvObj_t *nv){ text_print_flt_units(nv, fmt_tsf, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_tss(nvObj_t *nv){ text_print_flt_units(nv, fmt_tss, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_tsb(nvObj_t *nv){ text_print_flt_units(nv, fmt_tsb, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_prlf(nvObj_t *nv){ text_print_flt_units(nv, fmt_prlf, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_prlb(nvObj_t *nv){ text_print_flt_units(nv, fmt_prlb, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_prln(nvObj_t *nv){ text_print(nv, fmt_prln);}     // TYPE_INT
+void cm_print_prlt(nvObj_t *nv){ text_print_flt_units(nv, fmt_prlt, GET_UNITS(ACTIVE_MODEL));}
 void cm_print_sl(nvObj_t *nv) { text_print(nv, fmt_sl);}        // TYPE_INT
+void cm_print_tru(nvObj_t *nv){ text_print(nv, fmt_tru);}       // TYPE_INT
 void cm_print_lim(nvObj_t *nv){ text_print(nv, fmt_lim);}       // TYPE_INT
 void cm_print_saf(nvObj_t *nv){ text_print(nv, fmt_saf);}       // TYPE_INT
 
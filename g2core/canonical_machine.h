@@ -54,6 +54,11 @@
 #define JERK_INPUT_MIN      (0.01)          // minimum allowable jerk setting in millions mm/min^3
 #define JERK_INPUT_MAX      (1000000)       // maximum allowable jerk setting in millions mm/min^3
 #define PROBES_STORED       3               // we store three probes for coordinate rotation computation
+#define PROBE_LATCH_SAMPLES_MAX 8           // max latch samples averaged by two-pass probing
+#ifndef PROBE_HISTORY_SIZE
+#define PROBE_HISTORY_SIZE  128             // probe results kept for {prh} readout - may be set by the build
+#endif
+#define PROBE_HISTORY_LINES_PER_PASS 4      // probe history records streamed per main loop pass
 #define MAX_LINENUM         2000000000      // set 2 billion as max line number
 
 /*****************************************************************************
@@ -263,7 +268,16 @@ typedef struct cmMachine {                  // struct to manage canonical machin
     float junction_integration_time;        // how aggressively will the machine corner? 1.6 or so is about the upper limit
     float chordal_tolerance;                // arc chordal accuracy setting in mm
     float feedhold_z_lift;                  // mm to move Z axis on feedhold, or 0 to disable
+    float tool_setter_z;                    // machine Z at which a zero-length tool trips the tool setter
+    float tool_setter_fast_feed;            // G37 fast approach feed rate (mm/min)
+    float tool_setter_slow_feed;            // G37 slow latch feed rate (mm/min)
+    float tool_setter_backoff;              // G37 backoff distance from contact (mm)
+    float probe_latch_feed;                 // G38 slow latch feed rate (mm/min), 0 for single-pass probing
+    float probe_latch_backoff;              // G38 backoff from the fast contact before latching (mm)
+    uint8_t probe_latch_samples;            // number of latch samples averaged into the result
+    float probe_latch_tolerance;            // reject samples farther than this from the median (mm), 0 keeps all
     bool soft_limit_enable;                 // true to enable soft limit testing on Gcode inputs
+    bool traverse_uncoordinated;            // true to run each G0 axis at its own velocity max
     bool limit_enable;                      // true to enable limit switches (disabled is same as override)
 
     // Coordinate systems and offsets
@@ -456,6 +470,9 @@ stat_t cm_arc_feed(const float target[], const bool target_f[],             // G
                    const bool modal_g1_f,                                   // modal group flag for motion group
                    const cmMotionMode motion_mode);                         // defined motion mode
 
+stat_t cm_spindle_sync_feed(const float target[], const bool flags[],       // G33 - target endpoint
+                            const float K_word, const bool K_flag);         // K - travel per revolution
+
 // Spindle Functions (4.3.7)
 // see spindle.h for spindle functions - which would go right here
 
@@ -485,6 +502,8 @@ void cm_program_end(void);                                      // M2
 stat_t cm_json_command(char *json_string);                      // M100
 stat_t cm_json_command_immediate(char *json_string);            // M100.1
 stat_t cm_json_wait(char *json_string);                         // M102
+stat_t cm_wait_on_input(const float P_word, const bool P_flag,  // M66
+                        const uint8_t L_word, const float Q_word);
 
 /**** Cycles and External FIles ****/
 
@@ -511,8 +530,28 @@ stat_t cm_homing_cycle_callback(void);                          // G28.2/.4 main
 stat_t cm_straight_probe(float target[], bool flags[],          // G38.x
                          bool trip_sense, bool alarm_flag);
 stat_t cm_probing_cycle_callback(void);                         // G38.x main loop callback
+stat_t cm_probe_history_callback(void);                         // stream probe history to the TX buffer
+stat_t cm_get_prh(nvObj_t *nv);                                 // get sequence number of the last probe
+stat_t cm_set_prh(nvObj_t *nv);                                 // stream probe history from a sequence number
 stat_t cm_get_prbr(nvObj_t *nv);                                // enable/disable probe report
 stat_t cm_set_prbr(nvObj_t *nv);
+stat_t cm_tool_measure_cycle(float target[], bool flags[]);     // G37
+stat_t cm_get_tsz(nvObj_t *nv);                                 // tool setter settings
+stat_t cm_set_tsz(nvObj_t *nv);
+stat_t cm_get_tsf(nvObj_t *nv);
+stat_t cm_set_tsf(nvObj_t *nv);
+stat_t cm_get_tss(nvObj_t *nv);
+stat_t cm_set_tss(nvObj_t *nv);
+stat_t cm_get_tsb(nvObj_t *nv);
+stat_t cm_set_tsb(nvObj_t *nv);
+stat_t cm_get_prlf(nvObj_t *nv);                                // two-pass probing settings
+stat_t cm_set_prlf(nvObj_t *nv);
+stat_t cm_get_prlb(nvObj_t *nv);
+stat_t cm_set_prlb(nvObj_t *nv);
+stat_t cm_get_prln(nvObj_t *nv);
+stat_t cm_set_prln(nvObj_t *nv);
+stat_t cm_get_prlt(nvObj_t *nv);
+stat_t cm_set_prlt(nvObj_t *nv);
 
 // Jogging cycle (cycle_jogging.cpp)
 stat_t cm_jogging_cycle_callback(void);                         // jogging cycle main loop
@@ -600,6 +639,7 @@ stat_t cm_set_ra(nvObj_t *nv);          // set radius
 
 float cm_get_axis_jerk(const uint8_t axis);
 void cm_set_axis_max_jerk(const uint8_t axis, const float jerk);
+void cm_recalc_junction_accel(void);
 void cm_set_axis_high_jerk(const uint8_t axis, const float jerk);
 
 stat_t cm_get_vm(nvObj_t *nv);          // get velocity max
@@ -632,6 +672,8 @@ stat_t cm_get_zl(nvObj_t *nv);          // get feedhold Z lift
 stat_t cm_set_zl(nvObj_t *nv);          // set feedhold Z lift
 stat_t cm_get_sl(nvObj_t *nv);          // get soft limit enable
 stat_t cm_set_sl(nvObj_t *nv);          // set soft limit enable
+stat_t cm_get_tru(nvObj_t *nv);         // get uncoordinated traverse enable
+stat_t cm_set_tru(nvObj_t *nv);         // set uncoordinated traverse enable
 stat_t cm_get_lim(nvObj_t *nv);         // get hard limit enable
 stat_t cm_set_lim(nvObj_t *nv);         // set hard limit enable
 stat_t cm_get_saf(nvObj_t *nv);         // get safety interlock enable
@@ -706,7 +748,16 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     void cm_print_jt(nvObj_t *nv);          // global CM settings
     void cm_print_ct(nvObj_t *nv);
     void cm_print_zl(nvObj_t *nv);
+    void cm_print_tsz(nvObj_t *nv);
+    void cm_print_tsf(nvObj_t *nv);
+    void cm_print_tss(nvObj_t *nv);
+    void cm_print_tsb(nvObj_t *nv);
+    void cm_print_prlf(nvObj_t *nv);
+    void cm_print_prlb(nvObj_t *nv);
+    void cm_print_prln(nvObj_t *nv);
+    void cm_print_prlt(nvObj_t *nv);
     void cm_print_sl(nvObj_t *nv);
+    void cm_print_tru(nvObj_t *nv);
     void cm_print_lim(nvObj_t *nv);
     void cm_print_saf(nvObj_t *nv);
 
@@ -774,7 +825,16 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     #define cm_print_jt tx_print_stub       // global CM settings
     #define cm_print_ct tx_print_stub
     #define cm_print_zl tx_print_stub
+    #define cm_print_tsz tx_print_stub
+    #define cm_print_tsf tx_print_stub
+    #define cm_print_tss tx_print_stub
+    #define cm_print_tsb tx_print_stub
+    #define cm_print_prlf tx_print_stub
+    #define cm_print_prlb tx_print_stub
+    #define cm_print_prln tx_print_stub
+    #define cm_print_prlt tx_print_stub
     #define cm_print_sl tx_print_stub
+    #define cm_print_tru tx_print_stub
     #define cm_print_lim tx_print_stub
     #define cm_print_saf tx_print_stub
 
@@ -49,6 +49,9 @@ static void _set_defa(nvObj_t *nv, bool print);
 
 nvStr_t nvStr;
 nvList_t nvl;
+nvDump_t nvd = { -1, 0, 0, false };
+nvGroupDisplay_t nvg;
+bool nv_bulk_load = false;
 
 /***********************************************************************************
  **** CODE *************************************************************************
@@ -121,11 +124,18 @@ void config_init()
 /*
  * set_defaults() - reset persistence with default values for machine profile
  * _set_defa() - helper function and called directly from config_init()
+ *
+ *  Defaults are loaded as a bulk operation. While nv_bulk_load is set, setters whose
+ *  derived values depend only on the final raw values (e.g. junction acceleration from
+ *  jerk and junction time) skip their recalculation, which is run once at the end.
+ *  Derived values that depend on setter order (e.g. steps per unit) are still computed
+ *  in-line so the result is identical to loading the entries one at a time.
  */
 
 static void _set_defa(nvObj_t *nv, bool print)
 {
     cm_set_units_mode(MILLIMETERS);             // must do inits in MM mode
+    nv_bulk_load = true;
     for (nv->index=0; nv_index_is_single(nv->index); nv->index++) {
         if (cfgArray[nv->index].flags & F_INITIALIZE) {
             if ((cfgArray[nv->index].flags & TYPE_INTEGER) ||
@@ -141,6 +151,8 @@ static void _set_defa(nvObj_t *nv, bool print)
             }            
         }
     }
+    nv_bulk_load = false;
+    cm_recalc_junction_accel();                 // derived values deferred during the bulk load
     sr_init_status_report();                    // reset status reports
     if (print) {
         rpt_print_initializing_message();       // don't start TX until all the NVM persistence is done
@@ -364,6 +376,200 @@ stat_t set_grp(nvObj_t *nv)
     return (STAT_OK);
 }
 
+/***********************************************************************************
+ * Streaming configuration dump
+ *
+ *  get_dmp() - get the dump cursor: the next cfgArray index to send, or -1 if none
+ *  set_dmp() - start (or resume) a dump at the given cfgArray index
+ *  set_dpl() - set the dump page length in table entries (0 = run to the end of the table)
+ *  nv_dump_callback() - main loop callback that streams the dump
+ *
+ *  Group and uber-group displays build an nv list, so they are limited to NV_BODY_LEN
+ *  objects and need a round trip per group. {"dmp":0} instead streams every single
+ *  valued entry that is persisted - the whole saved configuration, including entries
+ *  with no group such as the status report list - one per line, straight from cfgArray.
+ *  Entries that aren't persisted are skipped; these are status values and commands, some
+ *  of which act when read (e.g. clear, panic). Each entry is read into a single nvObj and written to the TX
+ *  buffer; no list is built.
+ *
+ *  JSON lines carry the full token, e.g. {"xvm":1000}. Text mode lines use the entry's
+ *  print function, the same as $$. The dump writes NV_DUMP_LINES_PER_PASS entries per
+ *  main loop pass so the rest of the loop keeps running, and holds off new commands until
+ *  it is done so responses don't interleave. Control characters still get through.
+ *
+ *  If {"dpl":n} is non-zero the dump stops after n table entries. Either way it ends with the
+ *  cursor, {"dmp":n}, and {"dmp":n} picks up from there. The cursor is -1 after the last
+ *  entry. A dump that loses its connection stops and keeps its cursor for a resume.
+ */
+
+stat_t get_dmp(nvObj_t *nv)
+{
+    nv->value_int = nvd.cursor;
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
+stat_t set_dmp(nvObj_t *nv)
+{
+    if (nv->value_int < 0) {
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    if (!nv_index_is_single(nv->value_int)) {
+        return (STAT_INPUT_EXCEEDS_MAX_VALUE);
+    }
+    nvd.cursor = nv->value_int;
+    nvd.page_end = (nvd.page_len > 0) ? (nvd.cursor + nvd.page_len) : nv_index_max();
+    nvd.active = true;
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
+stat_t set_dpl(nvObj_t *nv)
+{
+    if (nv->value_int < 0) {
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    nvd.page_len = nv->value_int;
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
+static void _dump_entry(index_t index)
+{
+    nvObj_t nv;
+    nv.pv = NULL;                               // standalone object at depth 0
+    nv.nx = NULL;
+    nv.index = index;
+    nvStr.wp = 0;                               // string values are only needed for this line
+    nv_get_nvObj(&nv);
+    if ((nv.valuetype == TYPE_NULL) || (nv.valuetype == TYPE_EMPTY)) {
+        return;                                 // commands and other entries with no value
+    }
+    if (js.json_mode == TEXT_MODE) {
+        convert_outgoing_float(&nv);
+        nv_print(&nv);
+    } else {
+        strcpy(nv.token, cfgArray[index].token);// full token so the line stands on its own
+        json_serialize(&nv, cs.out_buf, sizeof(cs.out_buf));
+        xio_writeline(cs.out_buf);
+    }
+}
+
+static const char fmt_dmp_json[] = "{\"dmp\":%d}\n";
+static const char fmt_dmp_text[] = "[dmp] dump cursor%19d [-1=complete]\n";
+
+stat_t nv_dump_callback()
+{
+    if (!nvd.active) {
+        return (STAT_NOOP);
+    }
+    if (!xio_connected()) {                     // stop, keeping the cursor for a resume
+        nvd.active = false;
+        return (STAT_NOOP);
+    }
+    if (xio_tx_backed_up()) {                   // wait for the host to catch up
+        return (STAT_EAGAIN);
+    }
+    for (uint8_t i=0; i<NV_DUMP_LINES_PER_PASS; i++) {
+        if (!nv_index_is_single(nvd.cursor)) {  // end of the table
+            nvd.cursor = -1;
+            break;
+        }
+        if (nvd.cursor >= nvd.page_end) {       // end of the page
+            break;
+        }
+        if (cfgArray[nvd.cursor].flags & F_PERSIST) {   // only the saved configuration - status
+            _dump_entry(nvd.cursor);                    // values and commands may act when read
+        }
+        nvd.cursor++;
+    }
+    if ((nvd.cursor != -1) && (nvd.cursor < nvd.page_end)) {
+        return (STAT_EAGAIN);                   // more to send
+    }
+    nvd.active = false;
+    sprintf(cs.out_buf, (js.json_mode == TEXT_MODE) ? fmt_dmp_text : fmt_dmp_json, (int)nvd.cursor);
+    xio_writeline(cs.out_buf);
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * Streaming group displays
+ *
+ *  nv_display_group() - queue a group to be displayed
+ *  nv_group_display_active() - true while group displays are queued
+ *  nv_group_display_callback() - main loop callback that streams the queued groups
+ *
+ *  Uber-group displays ($$, $m, $q...) and text mode group displays are more output than
+ *  the TX queue holds, so writing them in one go would wait on the host. They are queued
+ *  here instead and written once the host has caught up, in the same way as the dump.
+ *  Text mode writes NV_DUMP_LINES_PER_PASS entries per pass using _dump_entry(), which
+ *  prints them as the group display did. JSON mode writes a group per pass - one response
+ *  line, which fits. New commands are held off until the display is done, and the text
+ *  mode prompt is sent at the end rather than ahead of the display.
+ */
+
+void nv_display_group(const char *group)
+{
+    if (nvg.count < NV_GROUP_DISPLAY_LEN) {
+        strncpy(nvg.group[nvg.count], group, GROUP_LEN);
+        nvg.group[nvg.count++][GROUP_LEN] = NUL;
+    }
+}
+
+bool nv_group_display_active() { return (nvg.cursor < nvg.count); }
+
+static void _display_group(const char *group)
+{
+    nv_reset_nv_list();
+    nvObj_t *nv = nv_body;
+    strncpy(nv->token, group, TOKEN_LEN);
+    nv->index = nv_get_index((const char *)"", nv->token);
+    nv_get_nvObj(nv);
+    nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_RESPONSE_FORMAT);
+}
+
+stat_t nv_group_display_callback()
+{
+    if (!nv_group_display_active()) {
+        return (STAT_NOOP);
+    }
+    if (!xio_connected()) {                     // nobody to show it to
+        nvg.count = 0;
+        nvg.cursor = 0;
+        return (STAT_NOOP);
+    }
+    if (xio_tx_backed_up()) {                   // wait for the host to catch up
+        return (STAT_EAGAIN);
+    }
+    if (js.json_mode == TEXT_MODE) {
+        uint8_t lines = 0;
+        while ((lines < NV_DUMP_LINES_PER_PASS) && (nvg.cursor < nvg.count)) {
+            if (!nv_index_is_single(nvg.entry)) {   // end of the table - on to the next group
+                nvg.cursor++;
+                nvg.entry = 0;
+                continue;
+            }
+            if (strcmp(nvg.group[nvg.cursor], cfgArray[nvg.entry].group) == 0) {
+                _dump_entry(nvg.entry);
+                lines++;
+            }
+            nvg.entry++;
+        }
+    } else {
+        _display_group(nvg.group[nvg.cursor++]);
+    }
+    if (nvg.cursor < nvg.count) {
+        return (STAT_EAGAIN);                   // more to send
+    }
+    nvg.count = 0;
+    nvg.cursor = 0;
+    nvg.entry = 0;
+    if (js.json_mode == TEXT_MODE) {
+        text_response(STAT_OK, (char *)"");     // the prompt held back by the controller
+    }
+    return (STAT_OK);
+}
+
 /***********************************************************************************
  ***** nvObj functions ************************************************************
  ***********************************************************************************/
@@ -447,6 +653,7 @@ void nv_coerce_types(nvObj_t *nv)
 /******************************************************************************
  * nvObj low-level object and list operations
  * nv_get_nvObj()       - setup a nv object by providing the index
+ * nv_load_nvObj()      - setup a nv object's group and token from the index, without a get
  * nv_reset_nv()        - quick clear for a new nv object
  * nv_reset_nv_list()   - clear entire header, body and footer for a new use
  * nv_copy_string()     - used to write a string to shared string storage and link it
@@ -473,6 +680,12 @@ void nv_get_nvObj(nvObj_t *nv)
 {
     if (nv->index >= nv_index_max()) { return; }    // sanity
 
+    nv_load_nvObj(nv);
+    ((fptrCmd)cfgArray[nv->index].get)(nv);     // populate the value
+}
+
+void nv_load_nvObj(nvObj_t *nv)
+{
     index_t tmp = nv->index;
     nv_reset_nv(nv);
     nv->index = tmp;
@@ -488,7 +701,6 @@ void nv_get_nvObj(nvObj_t *nv)
             strcpy(nv->token, &nv->token[strlen(nv->group)]); // strip group from the token
         }
     }
-    ((fptrCmd)cfgArray[nv->index].get)(nv);     // populate the value
 }
 
 nvObj_t *nv_reset_nv(nvObj_t *nv)               // clear a single nvObj structure
@@ -554,6 +766,15 @@ nvObj_t *nv_reset_exec_nv_list()                // clear the exec body
     return (nv_exec);                           // this is a convenience for calling routines
 }
 
+nvObj_t *nv_reset_queue_nv_list()               // clear the queue body
+{
+    nvObj_t *nv = nv_queue;
+
+    _nv_reset_a_list(nv, NV_QUEUE_LEN);
+
+    return (nv_queue);                          // this is a convenience for calling routines
+}
+
 stat_t nv_copy_string(nvObj_t *nv, const char *src)
 {
     if ((nvStr.wp + strlen(src)) > NV_SHARED_STRING_LEN) {
@@ -181,6 +181,9 @@ typedef uint16_t index_t;               // use this if there are > 255 indexed o
 #define NV_SHARED_STRING_LEN 1024        // shared string for string values
 #define NV_BODY_LEN 40                  // body elements - allow for 1 parent + N children
 #define NV_EXEC_LEN 10                  // elements reserved for exec, which won't directly respond
+#define NV_QUEUE_LEN 10                 // elements reserved for compiling queued JSON commands (M100)
+#define NV_DUMP_LINES_PER_PASS 4        // entries a streaming config dump writes per main loop pass
+#define NV_GROUP_DISPLAY_LEN 64         // groups a display command can queue ($$ queues about 50)
 // (each body element takes about 30 bytes of RAM)
 
 // Stuff you probably don't want to change
@@ -190,6 +193,7 @@ typedef uint16_t index_t;               // use this if there are > 255 indexed o
 #define NV_FOOTER_LEN 18                // sufficient space to contain a JSON footer array
 #define NV_LIST_LEN (NV_BODY_LEN+2)     // +2 allows for a header and a footer
 #define NV_EXEC_FIRST (NV_BODY_LEN+2)   // index of the first EXEC nv
+#define NV_QUEUE_FIRST (NV_EXEC_FIRST+NV_EXEC_LEN) // index of the first QUEUE nv
 #define NV_MAX_OBJECTS (NV_BODY_LEN-1)  // maximum number of objects in a body string
 #define NO_MATCH (index_t)0xFFFF
 
@@ -313,7 +317,7 @@ typedef void (*fptrPrint)(nvObj_t *nv); // required for program memory access
 
 typedef struct nvList {
     uint16_t magic_start;
-    nvObj_t list[NV_LIST_LEN+NV_EXEC_LEN]; // list of nv objects, including space for a JSON header element
+    nvObj_t list[NV_LIST_LEN+NV_EXEC_LEN+NV_QUEUE_LEN]; // list of nv objects, including space for a JSON header element
     uint16_t magic_end;
 } nvList_t;
 
@@ -329,16 +333,34 @@ typedef struct cfgItem {
     float def_value;                    // default value for config item
 } cfgItem_t;
 
+typedef struct nvDump {                 // streaming configuration dump - see nv_dump_callback()
+    int32_t cursor;                     // next cfgArray index to send, or -1 if none
+    int32_t page_end;                   // index that ends the current page
+    int32_t page_len;                   // entries per page, or 0 to run to the end of the table
+    bool active;                        // true while a dump is streaming
+} nvDump_t;
+
+typedef struct nvGroupDisplay {         // streaming group displays - see nv_group_display_callback()
+    char group[NV_GROUP_DISPLAY_LEN][GROUP_LEN+1]; // groups queued by the display command
+    uint8_t count;                      // number of groups queued
+    uint8_t cursor;                     // next group to send
+    index_t entry;                      // next cfgArray index to check for the current group (text mode)
+} nvGroupDisplay_t;
+
 /**** static allocation and definitions ****/
 
 extern nvStr_t nvStr;
 extern nvList_t nvl;
+extern nvDump_t nvd;
+extern nvGroupDisplay_t nvg;
+extern bool nv_bulk_load;               // true while _set_defa() loads the table - setters may defer derived values
 extern const cfgItem_t cfgArray[];
 
 //#define nv_header nv.list
 #define nv_header (&nvl.list[0])
 #define nv_body   (&nvl.list[1])
 #define nv_exec   (&nvl.list[NV_EXEC_FIRST])
+#define nv_queue  (&nvl.list[NV_QUEUE_FIRST])
 
 /**** Prototypes for generic config functions - see individual modules for application-specific functions  ****/
 
@@ -379,11 +401,22 @@ stat_t set_data(nvObj_t *nv);           // set uint32_t integer value blind cast
 stat_t set_grp(nvObj_t *nv);            // set data for a group
 stat_t get_grp(nvObj_t *nv);            // get data for a group
 
+stat_t nv_dump_callback(void);          // stream the config dump to the TX buffer
+stat_t get_dmp(nvObj_t *nv);            // get config dump cursor
+stat_t set_dmp(nvObj_t *nv);            // start or resume a config dump at a cursor
+stat_t set_dpl(nvObj_t *nv);            // set config dump page length
+
+void nv_display_group(const char *group);   // queue a group display
+bool nv_group_display_active(void);         // true while group displays are queued
+stat_t nv_group_display_callback(void);     // stream queued group displays to the TX buffer
+
 // nvObj and list functions
 void nv_get_nvObj(nvObj_t *nv);
+void nv_load_nvObj(nvObj_t *nv);
 nvObj_t *nv_reset_nv(nvObj_t *nv);
 nvObj_t *nv_reset_nv_list(void);
 nvObj_t *nv_reset_exec_nv_list();
+nvObj_t *nv_reset_queue_nv_list();
 stat_t nv_copy_string(nvObj_t *nv, const char *src);
 nvObj_t *nv_add_object(const char *token);
 nvObj_t *nv_add_integer(const char *token, const uint32_t value);
@@ -133,6 +133,11 @@ const cfgItem_t cfgArray[] = {
     { "", "admo",_i0, 0, cm_print_admo, cm_get_admo, set_ro, nullptr, 0 },    // arc distance mode
     { "", "frmo",_i0, 0, cm_print_frmo, cm_get_frmo, set_ro, nullptr, 0 },    // feed rate mode
     { "", "tool",_i0, 0, cm_print_tool, cm_get_toolv,set_ro, nullptr, 0 },    // active tool
+    { "", "jtot",_i0, 0, jp_print_jtot, jp_get_jtot, jp_set_jtot, nullptr, 0 },// job lines total - set to start job progress
+    { "", "jlin",_i0, 0, jp_print_jlin, jp_get_jlin, set_ro, nullptr, 0 },    // job lines consumed
+    { "", "jext",_f0, 1, jp_print_jext, jp_get_jext, set_ro, nullptr, 0 },    // job time executed (seconds)
+    { "", "jrem",_f0, 1, jp_print_jrem, jp_get_jrem, set_ro, nullptr, 0 },    // job time remaining (seconds)
+    { "", "jprg",_f0, 1, jp_print_jprg, jp_get_jprg, set_ro, nullptr, 0 },    // job progress (percent)
     { "", "g92e",_i0, 0, cm_print_g92e, cm_get_g92e, set_ro, nullptr, 0 },    // G92 enable state
 #ifdef TEMPORARY_HAS_LEDS
     { "", "_leds",_i0, 0, tx_print_nul, _get_leds,_set_leds, nullptr, 0 },    // TEMPORARY - change LEDs
@@ -221,9 +226,11 @@ const cfgItem_t cfgArray[] = {
     { "1","1tr",_fipc,5, st_print_tr, st_get_tr, st_set_tr, nullptr, M1_TRAVEL_PER_REV },
     { "1","1su",_fipi,5, st_print_su, st_get_su, st_set_su, nullptr, M1_STEPS_PER_UNIT },
     { "1","1mi",_iip, 0, st_print_mi, st_get_mi, st_set_mi, nullptr, M1_MICROSTEPS },
+    { "1","1mr",_iip, 0, st_print_mr, st_get_mr, st_set_mr, nullptr, M1_MICROSTEPS_RAPID },
     { "1","1po",_iip, 0, st_print_po, st_get_po, st_set_po, nullptr, M1_POLARITY },
     { "1","1pm",_iip, 0, st_print_pm, st_get_pm, st_set_pm, nullptr, M1_POWER_MODE },
     { "1","1pl",_fip, 3, st_print_pl, st_get_pl, st_set_pl, nullptr, M1_POWER_LEVEL },
+    { "1","1pc",_fip, 3, st_print_pc, st_get_pc, st_set_pc, nullptr, M1_POWER_LEVEL_CRUISE },
     { "1","1ep",_iip, 0, st_print_ep, st_get_ep, st_set_ep, nullptr, M1_ENABLE_POLARITY },
     { "1","1sp",_iip, 0, st_print_sp, st_get_sp, st_set_sp, nullptr, M1_STEP_POLARITY },
 //  { "1","1pi",_fip, 3, st_print_pi, st_get_pi, st_set_pi, (float *)&st_cfg.mot[MOTOR_1].power_idle,     M1_POWER_IDLE },
@@ -234,9 +241,11 @@ const cfgItem_t cfgArray[] = {
     { "2","2tr",_fipc,5, st_print_tr, st_get_tr, st_set_tr, nullptr, M2_TRAVEL_PER_REV },
     { "2","2su",_fipi,5, st_print_su, st_get_su, st_set_su, nullptr, M2_STEPS_PER_UNIT },
     { "2","2mi",_iip, 0, st_print_mi, st_get_mi, st_set_mi, nullptr, M2_MICROSTEPS },
+    { "2","2mr",_iip, 0, st_print_mr, st_get_mr, st_set_mr, nullptr, M2_MICROSTEPS_RAPID },
     { "2","2po",_iip, 0, st_print_po, st_get_po, st_set_po, nullptr, M2_POLARITY },
     { "2","2pm",_iip, 0, st_print_pm, st_get_pm, st_set_pm, nullptr, M2_POWER_MODE },
     { "2","2pl",_fip, 3, st_print_pl, st_get_pl, st_set_pl, nullptr, M2_POWER_LEVEL},
+    { "2","2pc",_fip, 3, st_print_pc, st_get_pc, st_set_pc, nullptr, M2_POWER_LEVEL_CRUISE },
     { "2","2ep",_iip, 0, st_print_ep, st_get_ep, st_set_ep, nullptr, M2_ENABLE_POLARITY },
     { "2","2sp",_iip, 0, st_print_sp, st_get_sp, st_set_sp, nullptr, M2_STEP_POLARITY },
 //  { "2","2pi",_fip, 3, st_print_pi, st_get_pi, st_set_pi, (float *)&st_cfg.mot[MOTOR_2].power_idle,     M2_POWER_IDLE },
@@ -248,9 +257,11 @@ const cfgItem_t cfgArray[] = {
     { "3","3tr",_fipc,5, st_print_tr, st_get_tr, st_set_tr, nullptr, M3_TRAVEL_PER_REV },
     { "3","3su",_fipi,5, st_print_su, st_get_su, st_set_su, nullptr, M3_STEPS_PER_UNIT },
     { "3","3mi",_iip, 0, st_print_mi, st_get_mi, st_set_mi, nullptr, M3_MICROSTEPS },
+    { "3","3mr",_iip, 0, st_print_mr, st_get_mr, st_set_mr, nullptr, M3_MICROSTEPS_RAPID },
     { "3","3po",_iip, 0, st_print_po, st_get_po, st_set_po, nullptr, M3_POLARITY },
     { "3","3pm",_iip, 0, st_print_pm, st_get_pm, st_set_pm, nullptr, M3_POWER_MODE },
     { "3","3pl",_fip, 3, st_print_pl, st_get_pl, st_set_pl, nullptr, M3_POWER_LEVEL },
+    { "3","3pc",_fip, 3, st_print_pc, st_get_pc, st_set_pc, nullptr, M3_POWER_LEVEL_CRUISE },
     { "3","3ep",_iip, 0, st_print_ep, st_get_ep, st_set_ep, nullptr, M3_ENABLE_POLARITY },
     { "3","3sp",_iip, 0, st_print_sp, st_get_sp, st_set_sp, nullptr, M3_STEP_POLARITY },
 //  { "3","3pi",_fip, 3, st_print_pi, st_get_pi, st_set_pi, (float *)&st_cfg.mot[MOTOR_3].power_idle,     M3_POWER_IDLE },
@@ -262,9 +273,11 @@ const cfgItem_t cfgArray[] = {
     { "4","4tr",_fipc,5, st_print_tr, st_get_tr, st_set_tr, nullptr, M4_TRAVEL_PER_REV },
     { "4","4su",_fipi,5, st_print_su, st_get_su, st_set_su, nullptr, M4_STEPS_PER_UNIT },
     { "4","4mi",_iip, 0, st_print_mi, st_get_mi, st_set_mi, nullptr, M4_MICROSTEPS },
+    { "4","4mr",_iip, 0, st_print_mr, st_get_mr, st_set_mr, nullptr, M4_MICROSTEPS_RAPID },
     { "4","4po",_iip, 0, st_print_po, st_get_po, st_set_po, nullptr, M4_POLARITY },
     { "4","4pm",_iip, 0, st_print_pm, st_get_pm, st_set_pm, nullptr, M4_POWER_MODE },
     { "4","4pl",_fip, 3, st_print_pl, st_get_pl, st_set_pl, nullptr, M4_POWER_LEVEL },
+    { "4","4pc",_fip, 3, st_print_pc, st_get_pc, st_set_pc, nullptr, M4_POWER_LEVEL_CRUISE },
     { "4","4ep",_iip, 0, st_print_ep, st_get_ep, st_set_ep, nullptr, M4_ENABLE_POLARITY },
     { "4","4sp",_iip, 0, st_print_sp, st_get_sp, st_set_sp, nullptr, M4_STEP_POLARITY },
 //  { "4","4pi",_fip, 3, st_print_pi, st_get_pi, st_set_pi, (float *)&st_cfg.mot[MOTOR_4].power_idle,     M4_POWER_IDLE },
@@ -276,9 +289,11 @@ const cfgItem_t cfgArray[] = {
     { "5","5tr",_fipc,5, st_print_tr, st_get_tr, st_set_tr, nullptr, M5_TRAVEL_PER_REV },
     { "5","5su",_fipi,5, st_print_su, st_get_su, st_set_su, nullptr, M5_STEPS_PER_UNIT },
     { "5","5mi",_iip, 0, st_print_mi, st_get_mi, st_set_mi, nullptr, M5_MICROSTEPS },
+    { "5","5mr",_iip, 0, st_print_mr, st_get_mr, st_set_mr, nullptr, M5_MICROSTEPS_RAPID },
     { "5","5po",_iip, 0, st_print_po, st_get_po, st_set_po, nullptr, M5_POLARITY },
     { "5","5pm",_iip, 0, st_print_pm, st_get_pm, st_set_pm, nullptr, M5_POWER_MODE },
     { "5","5pl",_fip, 3, st_print_pl, st_get_pl, st_set_pl, nullptr, M5_POWER_LEVEL },
+    { "5","5pc",_fip, 3, st_print_pc, st_get_pc, st_set_pc, nullptr, M5_POWER_LEVEL_CRUISE },
     { "5","5ep",_iip, 0, st_print_ep, st_get_ep, st_set_ep, nullptr, M5_ENABLE_POLARITY },
     { "5","5sp",_iip, 0, st_print_sp, st_get_sp, st_set_sp, nullptr, M5_STEP_POLARITY },
 //  { "5","5pi",_fip, 3, st_print_pi, st_get_pi, st_set_pi, (float *)&st_cfg.mot[MOTOR_5].power_idle,     M5_POWER_IDLE },
@@ -290,9 +305,11 @@ const cfgItem_t cfgArray[] = {
     { "6","6tr",_fipc,5, st_print_tr, st_get_tr, st_set_tr, nullptr, M6_TRAVEL_PER_REV },
     { "6","6su",_fipi,5, st_print_su, st_get_su, st_set_su, nullptr, M6_STEPS_PER_UNIT },
     { "6","6mi",_iip, 0, st_print_mi, st_get_mi, st_set_mi, nullptr, M6_MICROSTEPS },
+    { "6","6mr",_iip, 0, st_print_mr, st_get_mr, st_set_mr, nullptr, M6_MICROSTEPS_RAPID },
     { "6","6po",_iip, 0, st_print_po, st_get_po, st_set_po, nullptr, M6_POLARITY },
     { "6","6pm",_iip, 0, st_print_pm, st_get_pm, st_set_pm, nullptr, M6_POWER_MODE },
     { "6","6pl",_fip, 3, st_print_pl, st_get_pl, st_set_pl, nullptr, M6_POWER_LEVEL },
+    { "6","6pc",_fip, 3, st_print_pc, st_get_pc, st_set_pc, nullptr, M6_POWER_LEVEL_CRUISE },
     { "6","6ep",_iip, 0, st_print_ep, st_get_ep, st_set_ep, nullptr, M6_ENABLE_POLARITY },
     { "6","6sp",_iip, 0, st_print_sp, st_get_sp, st_set_sp, nullptr, M6_STEP_POLARITY },
 //  { "6","6pi",_fip, 3, st_print_pi, st_get_pi, st_set_pi, (float *)&st_cfg.mot[MOTOR_6].power_idle,     M6_POWER_IDLE },
@@ -729,7 +746,16 @@ const cfgItem_t cfgArray[] = {
     { "sys","jt",  _fipn, 2, cm_print_jt,  cm_get_jt,  cm_set_jt,  nullptr, JUNCTION_INTEGRATION_TIME },
     { "sys","ct",  _fipnc,4, cm_print_ct,  cm_get_ct,  cm_set_ct,  nullptr, CHORDAL_TOLERANCE },
     { "sys","zl",  _fipnc,3, cm_print_zl,  cm_get_zl,  cm_set_zl,  nullptr, FEEDHOLD_Z_LIFT },
+    { "sys","tsz", _fipnc,3, cm_print_tsz, cm_get_tsz, cm_set_tsz, nullptr, TOOL_SETTER_Z },
+    { "sys","tsf", _fipnc,3, cm_print_tsf, cm_get_tsf, cm_set_tsf, nullptr, TOOL_SETTER_FAST_FEED },
+    { "sys","tss", _fipnc,3, cm_print_tss, cm_get_tss, cm_set_tss, nullptr, TOOL_SETTER_SLOW_FEED },
+    { "sys","tsb", _fipnc,3, cm_print_tsb, cm_get_tsb, cm_set_tsb, nullptr, TOOL_SETTER_BACKOFF },
+    { "sys","prlf",_fipnc,3, cm_print_prlf,cm_get_prlf,cm_set_prlf,nullptr, PROBE_LATCH_FEED },
+    { "sys","prlb",_fipnc,3, cm_print_prlb,cm_get_prlb,cm_set_prlb,nullptr, PROBE_LATCH_BACKOFF },
+    { "sys","prln",_iipn, 0, cm_print_prln,cm_get_prln,cm_set_prln,nullptr, PROBE_LATCH_SAMPLES },
+    { "sys","prlt",_fipnc,3, cm_print_prlt,cm_get_prlt,cm_set_prlt,nullptr, PROBE_LATCH_TOLERANCE },
     { "sys","sl",  _bipn, 0, cm_print_sl,  cm_get_sl,  cm_set_sl,  nullptr, SOFT_LIMIT_ENABLE },
+    { "sys","tru", _bipn, 0, cm_print_tru, cm_get_tru, cm_set_tru, nullptr, TRAVERSE_UNCOORDINATED },
     { "sys","lim", _bipn, 0, cm_print_lim, cm_get_lim, cm_set_lim, nullptr, HARD_LIMIT_ENABLE },
     { "sys","saf", _bipn, 0, cm_print_saf, cm_get_saf, cm_set_saf, nullptr, SAFETY_INTERLOCK_ENABLE },
     { "sys","m48", _bin, 0, cm_print_m48,  cm_get_m48, cm_get_m48, nullptr, 1 },   // M48/M49 feedrate & spindle override enable
@@ -779,6 +805,10 @@ const cfgItem_t cfgArray[] = {
     { "", "tram", _b0, 0, cm_print_tram,cm_get_tram,cm_set_tram,nullptr,0 },    // SET to attempt setting rotation matrix from probes
     { "", "defa", _b0, 0, tx_print_nul,  help_defa,set_defaults,nullptr,0 },    // set/print defaults / help screen
     { "", "flash",_b0, 0, tx_print_nul,  help_flash,hw_flash,  nullptr, 0 },
+    { "", "dmp",  _i0, 0, tx_print_int,  get_dmp,   set_dmp,   nullptr, 0 },    // stream config dump from cursor
+    { "", "prh",  _i0, 0, tx_print_int,  cm_get_prh,cm_set_prh,nullptr, 0 },    // stream probe history from sequence number
+    { "", "qs",   _i0, 0, tx_print_int,  mp_get_qs, mp_set_qs, nullptr, 0 },    // stream planner queue snapshot
+    { "", "dpl",  _ii, 0, tx_print_int,  get_int32, set_dpl,   &nvd.page_len, 0 }, // config dump page length (0=all)
 
 #ifdef __HELP_SCREENS
     { "", "help",_b0, 0, tx_print_nul, help_config, set_nul, nullptr, 0 },  // prints config help screen
@@ -1630,12 +1660,7 @@ bool nv_group_is_prefixed(char *group)
 
 static void _do_group(nvObj_t *nv, char *group)   // helper to a group
 {
-    nv_reset_nv_list();
-    nv = nv_body;
-    strncpy(nv->token, group, TOKEN_LEN);
-    nv->index = nv_get_index((const char *)"", nv->token);
-    nv_get_nvObj(nv);
-    nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_RESPONSE_FORMAT);
+    nv_display_group(group);        // streamed from the main loop - see nv_group_display_callback()
 }
 
 static stat_t _do_group_list(nvObj_t *nv, char list[][TOKEN_LEN+1]) // helper to print multiple groups in a list
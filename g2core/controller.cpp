@@ -151,6 +151,7 @@ static void _controller_HSM()
 
     DISPATCH(hardware_periodic());              // give the hardware a chance to do stuff
     DISPATCH(_led_indicator());                 // blink LEDs at the current rate
+    DISPATCH(xio_tx_callback());                // move queued output to the host as it reads it
     DISPATCH(_shutdown_handler());              // invoke shutdown
     DISPATCH(_interlock_handler());             // invoke / remove safety interlock
     DISPATCH(temperature_callback());           // makes sure temperatures are under control
@@ -164,6 +165,9 @@ static void _controller_HSM()
     DISPATCH(st_motor_power_callback());        // stepper motor power sequencing
     DISPATCH(sr_status_report_callback());      // conditionally send status report
     DISPATCH(qr_queue_report_callback());       // conditionally send queue report
+    DISPATCH(mp_input_wait_callback());         // report the result of an input wait (M66)
+    DISPATCH(mp_inverse_time_callback());       // report G93 blocks that could not meet their time
+    DISPATCH(mp_spindle_sync_callback());       // alarm if a G33 thread lost its spindle sync
 
     // these 3 must be in this exact order:
     DISPATCH(mp_planner_callback());            // motion planner
@@ -182,8 +186,13 @@ static void _controller_HSM()
 
 //----- command readers and parsers --------------------------------------------------//
 
+    DISPATCH(nv_dump_callback());               // stream config dump - holds off new commands until done
+    DISPATCH(nv_group_display_callback());      // stream group displays - holds off new commands until done
+    DISPATCH(help_screen_callback());           // stream help screens - holds off new commands until done
+    DISPATCH(cm_probe_history_callback());      // stream probe history - holds off new commands until done
+    DISPATCH(mp_queue_snapshot_callback());     // stream planner queue snapshot - holds off new commands until done
     DISPATCH(_sync_to_planner());               // ensure there is at least one free buffer in planning queue
-    DISPATCH(_sync_to_tx_buffer());             // sync with TX buffer (pseudo-blocking)
+    DISPATCH(_sync_to_tx_buffer());             // hold off commands while the host isn't reading output
     DISPATCH(_dispatch_command());              // MUST BE LAST - read and execute next command
 }
 
@@ -215,6 +224,7 @@ static stat_t _dispatch_command()
     if (cs.controller_state != CONTROLLER_PAUSED) {
         devflags_t flags = DEV_IS_BOTH | DEV_IS_MUTED; // expressly state we'll handle muted devices
         if ((!mp_planner_is_full(mp)) && (cs.bufp = xio_readline(flags, cs.linelen)) != NULL) {
+            mp_input_line_received();               // line arrival times drive the planner startup policy
             _dispatch_kernel(flags);
         }
     }
@@ -277,7 +287,8 @@ static void _dispatch_kernel(const devflags_t flags)
         if (cs.comm_mode == AUTO_MODE) { js.json_mode = TEXT_MODE; } // switch to text mode
         cs.comm_request_mode = TEXT_MODE;                   // mode of this command
         status = text_parser(cs.bufp);
-        if (js.json_mode == TEXT_MODE) {                    // needed in case mode was changed by $EJ=1
+        if ((js.json_mode == TEXT_MODE) &&                  // needed in case mode was changed by $EJ=1
+            !nv_group_display_active() && !help_screen_active()) { // streamed displays prompt when done
             text_response(status, cs.saved_buf);
         }
     }
@@ -446,9 +457,16 @@ static stat_t _led_indicator()
 /*
  * _sync_to_tx_buffer() - return eagain if TX queue is backed up
  * _sync_to_planner() - return eagain if planner is not ready for a new command
+ *
+ *  Output never blocks the main loop - see xio write(). Instead new commands are not read
+ *  until there is room for their response, so a slow host holds off its own commands while
+ *  the planner and other callbacks keep running.
  */
 static stat_t _sync_to_tx_buffer()
 {
+    if (!xio_tx_has_headroom()) {
+        return (STAT_EAGAIN);
+    }
     return (STAT_OK);
 }
 
@@ -81,6 +81,8 @@ static stat_t _homing_axis_clear(int8_t axis);
 static stat_t _homing_axis_latch(int8_t axis);
 static stat_t _homing_axis_setpoint_backoff(int8_t axis);
 static stat_t _homing_axis_set_position(int8_t axis);
+static stat_t _homing_axis_set_homed(int8_t axis);
+static stat_t _homing_axis_queue(int8_t axis, float target, float velocity);
 static stat_t _homing_axis_move(int8_t axis, float target, float velocity);
 static stat_t _homing_error_exit(int8_t axis, stat_t status);
 static stat_t _homing_finalize_exit(int8_t axis);
@@ -118,6 +120,21 @@ static int8_t _get_next_axis(int8_t axis);
  *  4. Drive towards homing switch at latch velocity until switch is activated
  *  5. Back off switch by the zero backoff distance and set zero for that axis
  *
+ *  The zero is taken from the encoder snapshot the input interrupt records at the switch
+ *  edge in step 4, run through forward kinematics - not from where the latch move came to
+ *  rest. The decelerated stop overshoots the switch by an amount that grows with latch
+ *  velocity, but the snapshot is step-exact at the edge, so the latch can run much faster
+ *  without losing repeatability. If the switch is not closed when the latch move ends the
+ *  snapshot can't be trusted and the axis is zeroed from the stopping point as before.
+ *
+ *  Moves that don't depend on where the previous one stopped are queued together so the
+ *  planner doesn't drain and wait on a main loop round-trip between them: 1+2 (the clear
+ *  is a fixed-length move and the search is skipped by the switch), 3+4 (queued once the
+ *  search has stopped; the latch is skipped by the switch), and 5 with the end of the
+ *  axis when the zero came from the snapshot. A SKIP feedhold only discards the rest of
+ *  the running block, so each group ends with the one move the switch can cut short.
+ *  All homing moves run at the axis' high jerk {xjh}.
+ *
  *  Homing works as a state machine that is driven by registering a callback function
  *  at hm.func() for the next state to be run. Once the axis is initialized each
  *  callback basically does two things (1) start the move for the current function,
@@ -280,6 +297,7 @@ static stat_t _homing_axis_start(int8_t axis) {
  */
 static stat_t _homing_axis_clear_init(int8_t axis)  // first clear move
 {
+    cm_set_axis_max_jerk(axis, cm->a[axis].jerk_high);  // use the high-speed jerk for all homing moves
     if (gpio_read_input(hm.homing_input) == INPUT_ACTIVE) {  // the switch is closed at startup
 
         // determine if the input switch for this axis is shared w/other axes
@@ -289,9 +307,12 @@ static stat_t _homing_axis_clear_init(int8_t axis)  // first clear move
                     axis, STAT_HOMING_ERROR_MUST_CLEAR_SWITCHES_BEFORE_HOMING));  // axis cannot be homed
             }
         }
-        _homing_axis_move(axis, -hm.latch_backoff, hm.search_velocity);  // otherwise back off the switch
+        // otherwise back off the switch - the search follows without waiting for the stop
+        if (_homing_axis_queue(axis, -hm.latch_backoff, hm.search_velocity) != STAT_OK) {
+            return (STAT_HOMING_CYCLE_FAILED);
+        }
     }
-    return (_set_homing_func(_homing_axis_search));  // start the search
+    return (_homing_axis_search(axis));             // start the search
 }
 
 /***********************************************************************************
@@ -299,18 +320,19 @@ static stat_t _homing_axis_clear_init(int8_t axis)  // first clear move
  */
 static stat_t _homing_axis_search(int8_t axis)  // drive to switch
 {
-    cm_set_axis_max_jerk(axis, cm->a[axis].jerk_high);  // use the high-speed jerk for search onward
     _homing_axis_move(axis, hm.search_travel, hm.search_velocity);
     return (_set_homing_func(_homing_axis_clear));
 }
 
 /***********************************************************************************
- * _homing_axis_clear() - clear off the switch
+ * _homing_axis_clear() - clear off the switch, then queue the latch behind it
  */
 static stat_t _homing_axis_clear(int8_t axis)  // drive away from switch at search speed
 {
-    _homing_axis_move(axis, -hm.latch_backoff, hm.search_velocity);
-    return (_set_homing_func(_homing_axis_latch));
+    if (_homing_axis_queue(axis, -hm.latch_backoff, hm.search_velocity) != STAT_OK) {
+        return (STAT_HOMING_CYCLE_FAILED);
+    }
+    return (_homing_axis_latch(axis));
 }
 
 /***********************************************************************************
@@ -324,10 +346,24 @@ static stat_t _homing_axis_latch(int8_t axis)  // drive to switch at low speed
 
 /***********************************************************************************
  * _homing_axis_setpoint_backoff() - backoff to zero or max setpoint position
+ *
+ *  The switch edge is at setpoint - zero_backoff in homed coordinates. When latched the
+ *  axis position is set so the snapshot lands there, then the backoff also takes up the
+ *  overshoot of the latch stop so the move ends exactly on the setpoint. The axis is already
+ *  zeroed at that point, so it is finished without waiting for the backoff to stop.
  */
-static stat_t _homing_axis_setpoint_backoff(int8_t axis)  // 
+static stat_t _homing_axis_setpoint_backoff(int8_t axis)  //
 {
-    _homing_axis_move(axis, hm.zero_backoff, hm.search_velocity);
+    if (hm.set_coordinates && (gpio_read_input(hm.homing_input) == INPUT_ACTIVE)) {
+        float contact_position[AXES];
+        kn_forward_kinematics(en_get_encoder_snapshot_vector(), contact_position);
+        float overshoot = cm_get_absolute_position(ACTIVE_MODEL, axis) - contact_position[axis];
+        cm_set_position_by_axis(axis, hm.setpoint - hm.zero_backoff + overshoot);
+        _homing_axis_move(axis, hm.zero_backoff - overshoot, hm.search_velocity);
+        return (_homing_axis_set_homed(axis));
+    } else {
+        _homing_axis_move(axis, hm.zero_backoff, hm.search_velocity);
+    }
     return (_set_homing_func(_homing_axis_set_position));
 }
 
@@ -338,13 +374,25 @@ static stat_t _homing_axis_set_position(int8_t axis)
 {
     if (hm.set_coordinates) {
         cm_set_position_by_axis(axis, hm.setpoint);
-        cm->homed[axis] = true;
 
     } else {  // handle G28.4 cycle - set position to the point of switch closure
         float contact_position[AXES];
         kn_forward_kinematics(en_get_encoder_snapshot_vector(), contact_position);
         _homing_axis_move(axis, contact_position[AXIS_Z], hm.search_velocity);
     }
+    return (_homing_axis_set_homed(axis));
+}
+
+/***********************************************************************************
+ * _homing_axis_set_homed() - finish the axis and move on to the next one
+ *
+ *  Moves already queued were planned with the high jerk, so it can be restored here.
+ */
+static stat_t _homing_axis_set_homed(int8_t axis)
+{
+    if (hm.set_coordinates) {
+        cm->homed[axis] = true;
+    }
     cm_set_axis_max_jerk(axis, hm.saved_jerk);  // restore the max jerk value
 
     gpio_set_homing_mode(hm.homing_input, false);  // end homing mode
@@ -352,7 +400,8 @@ static stat_t _homing_axis_set_position(int8_t axis)
 }
 
 /***********************************************************************************
- * _homing_axis_move()       - helper that actually executes the above moves
+ * _homing_axis_queue()      - helper that queues one of the above moves
+ * _homing_axis_move()       - queue a move and wait for motion to stop before the next state
  * _motion_end_callback()    - callback completes when motion has stopped
  */
 static void _motion_end_callback(float* vect, bool* flag) 
@@ -360,12 +409,10 @@ static void _motion_end_callback(float* vect, bool* flag)
     hm.waiting_for_motion_end = false; 
 }
 
-static stat_t _homing_axis_move(int8_t axis, float target, float velocity) {
+static stat_t _homing_axis_queue(int8_t axis, float target, float velocity) {
     float vect[]  = INIT_AXES_ZEROES;
     bool  flags[] = INIT_AXES_ZEROES;
 
-    hm.waiting_for_motion_end = true;
-
     vect[axis]  = target;
     flags[axis] = true;
     cm_set_feed_rate(velocity);
@@ -375,6 +422,14 @@ static stat_t _homing_axis_move(int8_t axis, float target, float velocity) {
         rpt_exception(status, "Homing move failed. Check min/max settings");
         return (_homing_error_exit(axis, STAT_HOMING_CYCLE_FAILED));
     }
+    return (STAT_OK);
+}
+
+static stat_t _homing_axis_move(int8_t axis, float target, float velocity) {
+    if (_homing_axis_queue(axis, target, velocity) != STAT_OK) {
+        return (STAT_HOMING_CYCLE_FAILED);
+    }
+    hm.waiting_for_motion_end = true;
 
     // the last two arguments are ignored anyway
     mp_queue_command(_motion_end_callback, nullptr, nullptr);
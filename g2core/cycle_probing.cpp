@@ -30,6 +30,7 @@
 #include "json_parser.h"
 #include "text_parser.h"
 #include "canonical_machine.h"
+#include "controller.h"
 #include "kinematics.h"
 #include "encoder.h"
 #include "spindle.h"
@@ -63,18 +64,52 @@ struct pbProbingSingleton {             // persistent probing runtime variables
     cmDistanceMode saved_distance_mode; // G90,G91 global setting
     bool saved_soft_limits;             // turn off soft limits during probing
     float saved_jerk[AXES];             // saved and restored for each axis
+
+    float saved_feed_rate;              // feed rate from Gcode model, restored on exit
+    cmFeedRateMode saved_feed_rate_mode;// G93,G94 setting
+
+    // tool length measurement (G37) and two-pass probing
+    bool tool_measure;                  // true if running a tool measurement cycle
+    float backoff_target[AXES];         // position to back off to after a contact
+    float start[AXES];                  // position the probe started from
+    float latch_feed;                   // slow latch feed rate
+    float latch_backoff;                // distance to back off from a contact before each latch
+    uint8_t latch_samples;              // latch samples to take
+    uint8_t sample_count;               // latch samples taken so far
+    float samples[PROBE_LATCH_SAMPLES_MAX][AXES];   // latched contact positions
 };
 static struct pbProbingSingleton pb;
 
+typedef struct pbHistoryRecord {        // one probe result in the history ring
+    uint32_t seq;                       // probe sequence number, from 1
+    uint32_t time;                      // SysTick time the probe finished (ms)
+    cmProbeState state;                 // PROBE_SUCCEEDED or PROBE_FAILED
+    float position[AXES];               // absolute probe position
+} pbHistoryRecord_t;
+
+struct pbHistorySingleton {             // probe history ring and readout cursor
+    uint32_t seq;                       // sequence number of the last probe, 0 if none
+    uint32_t cursor;                    // next sequence number to stream
+    bool active;                        // true while a readout is streaming
+    pbHistoryRecord_t record[PROBE_HISTORY_SIZE];
+};
+static struct pbHistorySingleton ph;
+
 /**** NOTE: global prototypes and other .h info is located in canonical_machine.h ****/
 
 static stat_t _probing_start();
 static stat_t _probing_backoff();
+static stat_t _probing_seek_backoff();
+static stat_t _probing_latch();
+static stat_t _probing_latch_sample();
+static stat_t _probing_latch_finish(const float contact_position[]);
+static stat_t _tool_measure_retract(const float contact_position[]);
 static stat_t _probing_finish();
 static stat_t _probing_exception_exit(stat_t status);
 static stat_t _probe_move(const float target[], const bool flags[]);
 static void _motion_end_callback(float* vect, bool* flag);
 static void _send_probe_report(void);
+static void _record_probe_history(void);
 
 /***********************************************************************************
  **** G38.x Probing Cycle **********************************************************
@@ -148,9 +183,12 @@ uint8_t cm_straight_probe(float target[], bool flags[], bool trip_sense, bool al
     }
 
     // setup
+    pb.tool_measure = false;                // cm_tool_measure_cycle() sets this after calling here
     pb.alarm_flag = alarm_flag;             // set true to enable probe fail alarms (all exceptions alarm regardless)
     pb.trip_sense = trip_sense;             // set to sense of "tripped" contact
     pb.func = _probing_start;               // bind probing start function
+    pb.saved_feed_rate = cm->gm.feed_rate;  // two-pass and G37 cycles change the feed rate
+    pb.saved_feed_rate_mode = cm->gm.feed_rate_mode;
 
     cm_set_model_target(target, flags);     // convert target to canonical form taking all offsets into account
     copy_vector(pb.target, cm->gm.target);   // cm_set_model_target() sets target in gm, move it to pb
@@ -249,7 +287,8 @@ static uint8_t _probing_start()
     }
 
     // Error if the probe target is too close to the current position
-    if (get_axis_vector_length(cm->gmx.position, pb.target) < MINIMUM_PROBE_TRAVEL) {
+    copy_vector(pb.start, cm->gmx.position);
+    if (get_axis_vector_length(pb.start, pb.target) < MINIMUM_PROBE_TRAVEL) {
         return(_probing_exception_exit(STAT_PROBE_TRAVEL_TOO_SMALL));
     }
 
@@ -263,7 +302,19 @@ static uint8_t _probing_start()
 
     // Everything checks out. Run the probe move    
     _probe_move(pb.target, pb.flags);
-    pb.func = _probing_backoff;
+    if (pb.tool_measure) {                  // G37: the move above is the fast approach
+        pb.latch_feed = cm->tool_setter_slow_feed;
+        pb.latch_backoff = cm->tool_setter_backoff;
+        pb.latch_samples = 1;
+        pb.func = _probing_seek_backoff;
+    } else if (fp_NOT_ZERO(cm->probe_latch_feed)) {
+        pb.latch_feed = cm->probe_latch_feed;   // two-pass probe: the move above is the fast seek
+        pb.latch_backoff = cm->probe_latch_backoff;
+        pb.latch_samples = cm->probe_latch_samples;
+        pb.func = _probing_seek_backoff;
+    } else {
+        pb.func = _probing_backoff;
+    }
     return (STAT_EAGAIN);
 }
 
@@ -291,6 +342,220 @@ static stat_t _probing_backoff()
     return (STAT_EAGAIN);
 }
 
+/***********************************************************************************
+ * Two-pass probing
+ *
+ *  If the probe latch feed {prlf} is non-zero G38.x probes run in two passes:
+ *    - fast seek at the commanded feed rate with high jerk, as a single-pass probe
+ *    - back off {prlb} from the contact toward the start point with probing disabled
+ *    - slow latch at {prlf}, taking the encoder snapshot as the contact point
+ *    - repeat the backoff and latch until {prln} samples have been taken
+ *
+ *  Samples farther than {prlt} from the median sample are rejected and the rest are
+ *  averaged. If half or more of the samples are rejected the probe alarms, as the
+ *  contact is not repeatable. The probe finishes at the averaged contact point, which
+ *  is reported the same way as a single-pass probe. Failing to trip on the seek is a
+ *  probe failure (G38.2/.4 alarm); failing to trip on a latch is always an alarm.
+ *
+ *  G37 tool measurement runs the same seek, backoff and latch with the tool setter
+ *  settings and one sample - see cm_tool_measure_cycle(). Only the finish differs.
+ *
+ * _probing_set_backoff()  - set backoff target from a contact, back toward the start point
+ * _probing_average()      - reject outliers and average the latch samples
+ * _probing_seek_backoff() - back off after the fast seek, or fail if no contact
+ * _probing_latch()        - slow approach to latch the contact position
+ * _probing_latch_sample() - record a latch sample, then back off or finish
+ * _probing_latch_finish() - G38.x finish: move to the averaged contact point
+ */
+
+static void _probing_set_backoff(const float contact_position[])
+{
+    float length = get_axis_vector_length(pb.start, pb.target);
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        float unit = (pb.target[axis] - pb.start[axis]) / length;
+        pb.backoff_target[axis] = contact_position[axis] - unit * pb.latch_backoff;
+    }
+}
+
+static stat_t _probing_average(float result[])
+{
+    uint8_t n = pb.sample_count;
+
+    // the median sample is the one with the smallest total distance to the others
+    uint8_t median = 0;
+    float best = -1;
+    for (uint8_t i = 0; i < n; i++) {
+        float sum = 0;
+        for (uint8_t j = 0; j < n; j++) {
+            sum += get_axis_vector_length(pb.samples[i], pb.samples[j]);
+        }
+        if ((best < 0) || (sum < best)) {
+            best = sum;
+            median = i;
+        }
+    }
+
+    uint8_t kept = 0;
+    clear_vector(result);
+    for (uint8_t i = 0; i < n; i++) {
+        if (fp_NOT_ZERO(cm->probe_latch_tolerance) &&
+            (get_axis_vector_length(pb.samples[median], pb.samples[i]) > cm->probe_latch_tolerance)) {
+            continue;
+        }
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            result[axis] += pb.samples[i][axis];
+        }
+        kept++;
+    }
+    if ((n > 1) && ((kept * 2) <= n)) {
+        return (STAT_PROBE_SAMPLES_INCONSISTENT);
+    }
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        result[axis] /= kept;
+    }
+    return (STAT_OK);
+}
+
+static stat_t _probing_seek_backoff()
+{
+    if (pb.trip_sense != gpio_read_input(pb.probe_input)) {
+        cm->probe_state[0] = PROBE_FAILED;
+        pb.func = _probing_finish;
+        return (STAT_EAGAIN);
+    }
+    float contact_position[AXES];
+    kn_forward_kinematics(en_get_encoder_snapshot_vector(), contact_position);
+    _probing_set_backoff(contact_position);
+
+    pb.sample_count = 0;
+    gpio_set_probing_mode(pb.probe_input, false);  // releasing the probe must not stop the backoff
+    _probe_move(pb.backoff_target, pb.flags);
+    pb.func = _probing_latch;
+    return (STAT_EAGAIN);
+}
+
+static stat_t _probing_latch()
+{
+    if (pb.trip_sense == gpio_read_input(pb.probe_input)) {    // backoff did not clear the probe
+        return(_probing_exception_exit(STAT_PROBE_IS_ALREADY_TRIPPED));
+    }
+    gpio_set_probing_mode(pb.probe_input, true);
+    cm->gm.feed_rate = pb.latch_feed;
+    cm->gm.feed_rate_mode = UNITS_PER_MINUTE_MODE;
+    _probe_move(pb.target, pb.flags);
+    pb.func = _probing_latch_sample;
+    return (STAT_EAGAIN);
+}
+
+static stat_t _probing_latch_sample()
+{
+    if (pb.trip_sense != gpio_read_input(pb.probe_input)) {    // a latch that misses is not repeatable
+        return(_probing_exception_exit(STAT_PROBE_CYCLE_FAILED));
+    }
+    kn_forward_kinematics(en_get_encoder_snapshot_vector(), pb.samples[pb.sample_count++]);
+    gpio_set_probing_mode(pb.probe_input, false);
+
+    if (pb.sample_count < pb.latch_samples) {
+        _probing_set_backoff(pb.samples[pb.sample_count-1]);
+        _probe_move(pb.backoff_target, pb.flags);
+        pb.func = _probing_latch;
+        return (STAT_EAGAIN);
+    }
+
+    float contact_position[AXES];
+    stat_t status = _probing_average(contact_position);
+    if (status != STAT_OK) {
+        return(_probing_exception_exit(status));
+    }
+    if (pb.tool_measure) {
+        return (_tool_measure_retract(contact_position));
+    }
+    return (_probing_latch_finish(contact_position));
+}
+
+static stat_t _probing_latch_finish(const float contact_position[])
+{
+    cm->probe_state[0] = PROBE_SUCCEEDED;
+    _probe_move(contact_position, pb.flags);        // finish at the averaged contact point
+    pb.func = _probing_finish;
+    return (STAT_EAGAIN);
+}
+
+/***********************************************************************************
+ **** G37 Tool Length Measurement Cycle ********************************************
+ ***********************************************************************************/
+
+/***********************************************************************************
+ * cm_tool_measure_cycle() - G37 automatic tool length measurement
+ *
+ *  Measures the length of the active tool against a fixed tool setter and writes it
+ *  to the tool table and the active tool length offset. Z is the only axis measured;
+ *  the Z word is the farthest point to probe to, as in G38.2.
+ *
+ *  The cycle runs on the G38 probing machinery with high jerk:
+ *    - fast approach at the tool setter fast feed {tsf} until the setter trips
+ *    - back off {tsb} from the contact point with probing disabled
+ *    - slow latch at the tool setter slow feed {tss}, taking the encoder snapshot
+ *    - back off again, and write length = contact Z - setter reference {tsz}
+ *
+ *  The setter reference is the machine Z at which a zero-length tool (the spindle
+ *  gauge line) would trip the setter, so longer tools give positive lengths. Failing
+ *  to trip the setter is always an alarm. The contact point is reported as a probe.
+ */
+
+stat_t cm_tool_measure_cycle(float target[], bool flags[])
+{
+    if (!flags[AXIS_Z]) {
+        return(cm_alarm(STAT_AXIS_IS_MISSING, "Z axis is missing"));
+    }
+    if (fp_ZERO(cm->tool_setter_fast_feed) || fp_ZERO(cm->tool_setter_slow_feed)) {
+        return(cm_alarm(STAT_FEEDRATE_NOT_SPECIFIED, "Tool setter feedrate is zero"));
+    }
+
+    bool z_only[AXES];                      // the tool setter only measures Z
+    for (uint8_t axis = 0; axis < AXES; axis++) {
+        z_only[axis] = (axis == AXIS_Z);
+    }
+
+    // approach at the fast feed in units per minute mode - G38 setup uses the model feed rate
+    float saved_feed_rate = cm->gm.feed_rate;
+    cmFeedRateMode saved_feed_rate_mode = cm->gm.feed_rate_mode;
+    cm->gm.feed_rate = cm->tool_setter_fast_feed;
+    cm->gm.feed_rate_mode = UNITS_PER_MINUTE_MODE;
+
+    stat_t status = cm_straight_probe(target, z_only, true, true);
+    if (status != STAT_OK) {
+        cm->gm.feed_rate = saved_feed_rate;
+        cm->gm.feed_rate_mode = saved_feed_rate_mode;
+        return (status);
+    }
+    pb.saved_feed_rate = saved_feed_rate;   // restore the caller's feed rate, not the fast feed, on exit
+    pb.saved_feed_rate_mode = saved_feed_rate_mode;
+    pb.tool_measure = true;
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * _tool_measure_retract() - record the tool length and back off the setter
+ *
+ *  Called from _probing_latch_sample() once the contact has been latched.
+ */
+
+static stat_t _tool_measure_retract(const float contact_position[])
+{
+    cm->probe_state[0] = PROBE_SUCCEEDED;
+    copy_vector(cm->probe_results[0], contact_position);
+
+    tt.tt_offset[cm->gm.tool][AXIS_Z] = cm->probe_results[0][AXIS_Z] - cm->tool_setter_z;
+    cm->deferred_write_flag = true;                 // persist the tool table once the cycle is over
+
+    _probing_set_backoff(cm->probe_results[0]);
+    cm->gm.feed_rate = cm->tool_setter_fast_feed;
+    _probe_move(pb.backoff_target, pb.flags);
+    pb.func = _probing_finish;
+    return (STAT_EAGAIN);
+}
+
 /***********************************************************************************
  * _probe_restore_settings() - helper for both exits
  * _probing_exception_exit() - exit for probes that hit an exception
@@ -308,6 +573,8 @@ static void _probe_restore_settings()
     cm_set_distance_mode(pb.saved_distance_mode);
     cm_set_units_mode(pb.saved_units_mode);
     cm_set_soft_limits(pb.saved_soft_limits);
+    cm->gm.feed_rate = pb.saved_feed_rate;
+    cm->gm.feed_rate_mode = pb.saved_feed_rate_mode;
 
     cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);// cancel feed modes used during probing
     cm_canned_cycle_end();
@@ -324,16 +591,22 @@ static stat_t _probing_finish()
 {
     _probe_restore_settings();          // cleanup first
 
-    // set absolute position in probe results vector
-    for (uint8_t axis = 0; axis < AXES; axis++) {
-        cm->probe_results[0][axis] = cm_get_absolute_position(ACTIVE_MODEL, axis);
-    }    
+    if (pb.tool_measure) {              // tool measurement already recorded the contact point
+        if (cm->probe_state[0] == PROBE_SUCCEEDED) {
+            cm_set_tl_offset(cm->gm.tool, true, false); // apply the new length to the active tool
+        }
+    } else {                            // set absolute position in probe results vector
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            cm->probe_results[0][axis] = cm_get_absolute_position(ACTIVE_MODEL, axis);
+        }
+    }
     // handle failed probes - successful probes already set the flag
     if (cm->probe_state[0] == PROBE_FAILED) {
         if (pb.alarm_flag) {
             cm_alarm(STAT_PROBE_CYCLE_FAILED, "probing failed");
         }
     }
+    _record_probe_history();
     _send_probe_report();
     return (STAT_OK);
 }
@@ -371,9 +644,113 @@ static void _send_probe_report() {
     }
 }
 
+/***********************************************************************************
+ * Probe history
+ *
+ *  Every completed probe, successful or not, is recorded in a ring of PROBE_HISTORY_SIZE
+ *  records tagged with a sequence number, the probe state and the SysTick time. Probing
+ *  workflows can run back-to-back and read the results in bulk afterwards.
+ *
+ *  {"prh":n} streams every record still in the ring with sequence number n or later, one
+ *  per line as {"prh":[seq,e,time,x,y,z,u,v,w,a,b,c]}, and ends with {"prh":next}, where
+ *  next is the sequence number to ask for to get only newer probes. {"prh":0} streams the
+ *  whole ring. Reading {"prh":n} returns the sequence number of the last probe.
+ *
+ *  The readout writes PROBE_HISTORY_LINES_PER_PASS records per main loop pass and holds off
+ *  new commands until it is done, the same as the config dump {dmp}.
+ *
+ * _record_probe_history()     - add the current probe result to the ring
+ * cm_get_prh()                - get sequence number of the last probe
+ * cm_set_prh()                - start a readout from a sequence number
+ * cm_probe_history_callback() - main loop callback that streams the readout
+ */
+
+static void _record_probe_history()
+{
+    pbHistoryRecord_t *r = &ph.record[ph.seq % PROBE_HISTORY_SIZE];
+    r->seq = ++ph.seq;
+    r->time = SysTickTimer_getValue();
+    r->state = cm->probe_state[0];
+    copy_vector(r->position, cm->probe_results[0]);
+}
+
+stat_t cm_get_prh(nvObj_t *nv)
+{
+    nv->value_int = ph.seq;
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
+stat_t cm_set_prh(nvObj_t *nv)
+{
+    if (nv->value_int < 0) {
+        return (STAT_INPUT_LESS_THAN_MIN_VALUE);
+    }
+    uint32_t oldest = (ph.seq > PROBE_HISTORY_SIZE) ? (ph.seq - PROBE_HISTORY_SIZE + 1) : 1;
+    ph.cursor = max((uint32_t)nv->value_int, oldest);   // older records have been overwritten
+    ph.active = true;
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
+static const char fmt_prh_json[] = "{\"prh\":%lu}\n";
+static const char fmt_prh_text[] = "[prh] next probe sequence%11lu\n";
+
+stat_t cm_probe_history_callback()
+{
+    if (!ph.active) {
+        return (STAT_NOOP);
+    }
+    if (!xio_connected()) {
+        ph.active = false;
+        return (STAT_NOOP);
+    }
+    if (xio_tx_backed_up()) {                   // wait for the host to catch up
+        return (STAT_EAGAIN);
+    }
+    for (uint8_t i=0; (i < PROBE_HISTORY_LINES_PER_PASS) && (ph.cursor <= ph.seq); i++) {
+        pbHistoryRecord_t *r = &ph.record[(ph.cursor - 1) % PROBE_HISTORY_SIZE];
+        char *bufp = cs.out_buf;
+        if (js.json_mode == TEXT_MODE) {
+            bufp += sprintf(bufp, "[prh] %lu %d %lu", (unsigned long)r->seq, (int)r->state, (unsigned long)r->time);
+        } else {
+            bufp += sprintf(bufp, "{\"prh\":[%lu,%d,%lu", (unsigned long)r->seq, (int)r->state, (unsigned long)r->time);
+        }
+        for (uint8_t axis = 0; axis < AXES; axis++) {
+            bufp += sprintf(bufp, (js.json_mode == TEXT_MODE) ? " %0.3f" : ",%0.3f", r->position[axis]);
+        }
+        strcpy(bufp, (js.json_mode == TEXT_MODE) ? "\n" : "]}\n");
+        xio_writeline(cs.out_buf);
+        ph.cursor++;
+    }
+    if (ph.cursor <= ph.seq) {
+        return (STAT_EAGAIN);                   // more to send
+    }
+    ph.active = false;
+    sprintf(cs.out_buf, (js.json_mode == TEXT_MODE) ? fmt_prh_text : fmt_prh_json, (unsigned long)ph.cursor);
+    xio_writeline(cs.out_buf);
+    return (STAT_OK);
+}
+
 /*
  * cm_get_prbr() - get probe report enable setting
  * cm_set_prbr() - set probe report enable setting
+ * cm_get_tsz() - get tool setter reference Z
+ * cm_set_tsz() - set tool setter reference Z
+ * cm_get_tsf() - get tool setter fast approach feed rate
+ * cm_set_tsf() - set tool setter fast approach feed rate
+ * cm_get_tss() - get tool setter slow latch feed rate
+ * cm_set_tss() - set tool setter slow latch feed rate
+ * cm_get_tsb() - get tool setter backoff distance
+ * cm_set_tsb() - set tool setter backoff distance
+ * cm_get_prlf() - get probe latch feed rate
+ * cm_set_prlf() - set probe latch feed rate
+ * cm_get_prlb() - get probe latch backoff distance
+ * cm_set_prlb() - set probe latch backoff distance
+ * cm_get_prln() - get number of probe latch samples
+ * cm_set_prln() - set number of probe latch samples
+ * cm_get_prlt() - get probe sample rejection tolerance
+ * cm_set_prlt() - set probe sample rejection tolerance
  */
 
 stat_t cm_get_prbr(nvObj_t *nv)
@@ -388,3 +765,20 @@ stat_t cm_set_prbr(nvObj_t *nv)
     cm->probe_report_enable = nv->value_int;
     return (STAT_OK);
 }
+
+stat_t cm_get_tsz(nvObj_t *nv) { return(get_float(nv, cm->tool_setter_z)); }
+stat_t cm_set_tsz(nvObj_t *nv) { return(set_float(nv, cm->tool_setter_z)); }
+stat_t cm_get_tsf(nvObj_t *nv) { return(get_float(nv, cm->tool_setter_fast_feed)); }
+stat_t cm_set_tsf(nvObj_t *nv) { return(set_float_range(nv, cm->tool_setter_fast_feed, 0, 10000000)); }
+stat_t cm_get_tss(nvObj_t *nv) { return(get_float(nv, cm->tool_setter_slow_feed)); }
+stat_t cm_set_tss(nvObj_t *nv) { return(set_float_range(nv, cm->tool_setter_slow_feed, 0, 10000000)); }
+stat_t cm_get_tsb(nvObj_t *nv) { return(get_float(nv, cm->tool_setter_backoff)); }
+stat_t cm_set_tsb(nvObj_t *nv) { return(set_float_range(nv, cm->tool_setter_backoff, MINIMUM_PROBE_TRAVEL, 10000000)); }
+stat_t cm_get_prlf(nvObj_t *nv) { return(get_float(nv, cm->probe_latch_feed)); }
+stat_t cm_set_prlf(nvObj_t *nv) { return(set_float_range(nv, cm->probe_latch_feed, 0, 10000000)); }
+stat_t cm_get_prlb(nvObj_t *nv) { return(get_float(nv, cm->probe_latch_backoff)); }
+stat_t cm_set_prlb(nvObj_t *nv) { return(set_float_range(nv, cm->probe_latch_backoff, MINIMUM_PROBE_TRAVEL, 10000000)); }
+stat_t cm_get_prln(nvObj_t *nv) { return(get_integer(nv, cm->probe_latch_samples)); }
+stat_t cm_set_prln(nvObj_t *nv) { return(set_integer(nv, cm->probe_latch_samples, 1, PROBE_LATCH_SAMPLES_MAX)); }
+stat_t cm_get_prlt(nvObj_t *nv) { return(get_float(nv, cm->probe_latch_tolerance)); }
+stat_t cm_set_prlt(nvObj_t *nv) { return(set_float_range(nv, cm->probe_latch_tolerance, 0, 10000000)); }
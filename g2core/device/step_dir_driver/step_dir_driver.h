@@ -81,6 +81,10 @@ struct StepDirStepper final : Stepper  {
 
     bool canStep() override { return !_step.isNull(); };
 
+    bool canSwitchMicrosteps() override {
+        return (!_enable.isNull() && !_ms0.isNull() && !_ms1.isNull() && !_ms2.isNull());
+    };
+
     void setMicrosteps(const uint8_t microsteps) override {
         if (!_enable.isNull()) {
             switch (microsteps) {
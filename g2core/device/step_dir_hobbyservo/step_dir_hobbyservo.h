@@ -40,6 +40,33 @@ using Motate::kStartHigh;
 using Motate::kNormal;
 using Motate::Timeout;
 
+/*
+ * Hobby servo output smoothing
+ *
+ *  Steps only move the commanded position. The PWM output is updated from a SysTick
+ *  event once per PWM period, and follows the commanded position through a first-order
+ *  filter (HOBBYSERVO_SMOOTHING, 1.0 = no filtering) with an optional slew limit
+ *  (HOBBYSERVO_MAX_SLEW, in full servo ranges per second, 0 = unlimited). The update makes
+ *  sure the final position is always applied even if the last step arrives between updates.
+ *  Both are off by default, as filtering adds lag. Boards can define a smoothing below 1.0
+ *  (e.g. 0.35) to take step-to-step and segment-boundary jitter out of the servo.
+ *
+ *  The PWM runs at the 50 Hz of the original servo spec, which every servo accepts. Digital
+ *  servos generally take a frame down to about 3 mSec - boards that drive them can define
+ *  HOBBYSERVO_PWM_FREQUENCY higher (e.g. 200) for faster updates. Don't raise it for analog
+ *  servos, which can overheat when driven at a high frame rate. The output filter steps once
+ *  per PWM period, so a higher rate also makes HOBBYSERVO_SMOOTHING settle faster.
+ */
+#ifndef HOBBYSERVO_PWM_FREQUENCY
+#define HOBBYSERVO_PWM_FREQUENCY    50      // Hz - must leave room for a 2000 uSec pulse
+#endif
+#ifndef HOBBYSERVO_SMOOTHING
+#define HOBBYSERVO_SMOOTHING        1.0     // fraction of remaining error removed per update (0.0 < x <= 1.0)
+#endif
+#ifndef HOBBYSERVO_MAX_SLEW
+#define HOBBYSERVO_MAX_SLEW         0.0     // full ranges per second, 0 for no limit
+#endif
+
 
 // Motor structures
 template <pin_number pwm_pin_num>  // Setup a stepper template to hold our pins
@@ -48,17 +75,24 @@ struct StepDirHobbyServo final : Stepper {
 
     int16_t                _microsteps_per_step = 1;
     bool                   _step_is_forward = false;
-    int32_t                _position = 0; // in steps from 0 - 6400 for a full "rotation"
-    int32_t                _position_computed = 0; // in steps from 0 - 6400 for a full "rotation"
+    volatile int32_t       _position = 0; // in steps from 0 - 6400 for a full "rotation"
+    float                  _position_computed = 0; // filtered PWM value being output
     float                  _min_value;
     float                  _max_value;
     float                  _value_range;
+    float                  _smoothing;              // filter coefficient, 1.0 = follow steps directly
+    float                  _max_slew;               // max change in PWM value per update, 0 = no limit
+    uint16_t               _applied_value = 0;      // PWM value last written to the pin
+    uint8_t                _update_ticks;           // SysTicks (mSec) per output update - one PWM period
+    uint8_t                _update_countdown = 1;
     bool                   _enabled = false;
     PWMOutputPin<pwm_pin_num> _pwm_pin;
-    Motate::Timeout check_timer;
+    Motate::SysTickEvent   _update_event {[&] { _updateOutput(); }, nullptr};
 
     // sets default pwm freq for all motor vrefs (commented line below also sets HiZ)
-    StepDirHobbyServo(const uint32_t frequency = 50) : Stepper{}, _pwm_pin{kNormal, frequency} {
+    StepDirHobbyServo(const uint32_t frequency = HOBBYSERVO_PWM_FREQUENCY,
+                      const float smoothing = HOBBYSERVO_SMOOTHING,
+                      const float max_slew = HOBBYSERVO_MAX_SLEW) : Stepper{}, _pwm_pin{kNormal, frequency} {
         _pwm_pin.setFrequency(frequency); // redundant due to a bug
         uint16_t _top_value = _pwm_pin.getTopValue();
         float frequency_inv = 1.0/(float)frequency;
@@ -66,15 +100,57 @@ struct StepDirHobbyServo final : Stepper {
         _max_value = (float)_top_value / ((frequency_inv)/(2000.0/1000000.0));
         _value_range = _max_value - _min_value;
         _position_computed = _min_value;
-        check_timer.set(1);
+
+        _update_ticks = (1000 + frequency - 1) / frequency;     // round up to whole mSec
+        if (_update_ticks == 0) { _update_ticks = 1; }
+        _smoothing = ((smoothing > 0.0) && (smoothing < 1.0)) ? smoothing : 1.0;
+        _max_slew = max_slew * _value_range * _update_ticks / 1000.0;
     };
 
     /* Optional override of init */
 
+    void init() override {
+        Motate::SysTickTimer.registerEvent(&_update_event);
+        Stepper::init();
+    };
+
+    // Called from SysTick. Moves the output toward the commanded position, once per PWM period.
+    void _updateOutput() {
+        if (!_enabled || --_update_countdown) { return; }
+        _update_countdown = _update_ticks;
+
+        float used_position = _position;
+        if (used_position > 6400.0) {
+            used_position = 6400.0;
+        }
+        if (used_position < 0.0) {
+            used_position = 0.0;
+        }
+        float target = _min_value + ((used_position/6400.0) * _value_range);
+
+        float delta = (target - _position_computed) * _smoothing;
+        if ((delta < 0.5) && (delta > -0.5)) {
+            delta = target - _position_computed;                // close enough - settle exactly on target
+        }
+        if (_max_slew > 0.0) {
+            if (delta > _max_slew) { delta = _max_slew; }
+            else if (delta < -_max_slew) { delta = -_max_slew; }
+        }
+        _position_computed += delta;
+
+        uint16_t value = (uint16_t)(_position_computed + 0.5);
+        if (value != _applied_value) {
+            _applied_value = value;
+            _pwm_pin.setExactDutyCycle(value, true);            // apply the change
+        }
+    };
+
     /* Functions that must be implemented in subclasses */
 
     bool canStep() override { return true; };
 
+    bool canSwitchMicrosteps() override { return true; };
+
     void setMicrosteps(const uint8_t microsteps) override {
         switch (microsteps) {
             case (1): {
@@ -106,7 +182,8 @@ struct StepDirHobbyServo final : Stepper {
 
     void _enableImpl() override {
         _enabled = true;
-        _pwm_pin.setExactDutyCycle(_position_computed, true);
+        _applied_value = (uint16_t)(_position_computed + 0.5);
+        _pwm_pin.setExactDutyCycle(_applied_value, true);
     };
 
     void _disableImpl() override {
@@ -122,20 +199,6 @@ struct StepDirHobbyServo final : Stepper {
         } else {
             _position -= _microsteps_per_step;
         }
-
-        if (!check_timer.isPast()) { return; }
-        check_timer.set(10);
-
-        float used_position = _position;
-        if (used_position > 6400.0) {
-            used_position = 6400.0;
-        }
-        if (used_position < 0.0) {
-            used_position = 0.0;
-        }
-
-        _position_computed = _min_value + ((used_position/6400.0) * _value_range);
-        _pwm_pin.setExactDutyCycle(_position_computed, true); // apply the change
     };
 
     void stepEnd() override {
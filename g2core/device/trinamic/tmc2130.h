@@ -87,6 +87,12 @@ struct Trinamic2130 final : Stepper {
     // Timer to keep track of when we need to do another periodic update
     Motate::Timeout check_timer;
 
+    // Run current requested by the stepper loader. The loader runs in the DDA ISR,
+    // so it only records the value and the write is started from SysTick
+    volatile uint8_t _motion_power_irun = 0;
+    volatile bool _motion_power_pending = false;
+    Motate::SysTickEvent _motion_power_event {[&] { _startMotionPowerWrite(); }, nullptr};
+
     // Constructor - this is the only time we directly use the SBIBus
     template <typename SPIBus_t, typename chipSelect_t>
     Trinamic2130(SPIBus_t &spi_bus, const chipSelect_t &_cs) :
@@ -147,6 +153,11 @@ struct Trinamic2130 final : Stepper {
 
     void setPowerLevel(float new_pl) override
     {
+        // SysTick also writes IRUN (_startMotionPowerWrite()), so the bitfield update
+        // must not be interrupted
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+
         // scale the 0.0-1.0 to 0-31
         IHOLD_IRUN.IRUN = (new_pl * 31.0);
 
@@ -154,9 +165,37 @@ struct Trinamic2130 final : Stepper {
         IHOLD_IRUN.IHOLD = (new_pl * 31.0);
 
         IHOLD_IRUN_needs_written = true;
+        __set_PRIMASK(primask);
         _startNextReadWrite();
     };
 
+    // Called from the stepper loader at section boundaries. Only the run current
+    // changes - the hold current stays at the power level. Nothing is touched on the
+    // SPI bus here; the write is started by _startMotionPowerWrite() on the next tick.
+    void setMotionPowerLevel(float new_pl) override
+    {
+        _motion_power_irun = (new_pl * 31.0);
+        _motion_power_pending = true;
+    };
+
+    // Called from SysTick. Applies a requested run current and keeps starting transfers
+    // until it has been written, since the SPI done callback doesn't chain them.
+    void _startMotionPowerWrite()
+    {
+        if (!_inited) { return; }
+        if (_motion_power_pending) {
+            uint32_t primask = __get_PRIMASK();
+            __disable_irq();
+            _motion_power_pending = false;
+            IHOLD_IRUN.IRUN = _motion_power_irun;
+            IHOLD_IRUN_needs_written = true;
+            __set_PRIMASK(primask);
+        }
+        if (IHOLD_IRUN_needs_written && !_transmitting) {
+            _startNextReadWrite();
+        }
+    };
+
     // Note that init() and periodicCheck(bool have_actually_stopped) are both below
 
 
@@ -456,8 +495,13 @@ struct Trinamic2130 final : Stepper {
 
     void _startNextReadWrite()
     {
-        if (_transmitting || !_inited) { return; }
+        // This can be called from SysTick as well as the main loop, so the test-and-set
+        // of the mutex must not be interrupted
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        if (_transmitting || !_inited) { __set_PRIMASK(primask); return; }
         _transmitting = true; // preemptively say we're transmitting .. as a mutex
+        __set_PRIMASK(primask);
 
         // We request the next register, or re-request that we're reading (and already requested) in order to get the response.
         int16_t next_reg;
@@ -622,6 +666,7 @@ struct Trinamic2130 final : Stepper {
         _inited = true;
         _startNextReadWrite();
         check_timer.set(100);
+        Motate::SysTickTimer.registerEvent(&_motion_power_event);
 
         Stepper::init();
     };
@@ -29,6 +29,7 @@
 #include "config.h"
 #include "encoder.h"
 #include "canonical_machine.h"  // needed for cm_panic() in assertions
+#include "util.h"
 
 /**** Allocate Structures ****/
 
@@ -118,6 +119,74 @@ float en_get_encoder_snapshot_steps(uint8_t motor) { return (en.snapshot[motor])
 
 float* en_get_encoder_snapshot_vector() { return (en.snapshot); }
 
+/*
+ * en_spindle_index()         - record a spindle index pulse (called from the input interrupt)
+ * en_spindle_arm()           - take a new phase reference at the next index pulse
+ * en_spindle_is_referenced() - true once the armed reference has been taken
+ * en_spindle_rpm()           - measured spindle speed, 0 if stopped or not yet measured
+ * en_spindle_revolutions()   - spindle revolutions since the phase reference
+ *
+ *  The spindle "encoder" is a single index pulse per revolution on an input set to
+ *  INPUT_FUNCTION_SPINDLE_INDEX. Speed comes from the filtered period between pulses
+ *  and position within a revolution is interpolated from the time since the last
+ *  pulse, both at SysTick (1 ms) resolution. The input's lockout time must be shorter
+ *  than a revolution at the highest speed used for threading. An index-only sensor
+ *  cannot tell direction, so speeds and revolutions are always positive.
+ */
+
+void en_spindle_index()
+{
+    uint32_t now = SysTickTimer_getValue();
+    float period = (float)(now - en.spindle.index_tick);
+
+    if ((en.spindle.index_count == 0) || (period > SPINDLE_INDEX_TIMEOUT_MS)) {
+        en.spindle.rev_ms = 0;                      // first pulse after a stop only sets the time
+    } else if (fp_ZERO(en.spindle.rev_ms)) {
+        en.spindle.rev_ms = period;
+    } else {
+        en.spindle.rev_ms += (period - en.spindle.rev_ms) * SPINDLE_INDEX_FILTER;
+    }
+    en.spindle.index_tick = now;
+    en.spindle.index_count++;
+
+    if (en.spindle.armed) {
+        en.spindle.ref_count = en.spindle.index_count;
+        en.spindle.armed = false;
+    }
+}
+
+void en_spindle_arm() { en.spindle.armed = true; }
+
+bool en_spindle_is_referenced() { return (!en.spindle.armed); }
+
+float en_spindle_rpm()
+{
+    float rev_ms = en.spindle.rev_ms;
+    float elapsed = (float)(SysTickTimer_getValue() - en.spindle.index_tick);
+
+    if (fp_ZERO(rev_ms) || (elapsed > SPINDLE_INDEX_TIMEOUT_MS)) {
+        return (0);
+    }
+    return (60000 / std::max(rev_ms, elapsed));     // a late pulse means the spindle is slowing
+}
+
+float en_spindle_revolutions()
+{
+    uint32_t count, tick;
+    do {                                            // re-read if an index pulse lands in between
+        count = en.spindle.index_count;
+        tick = en.spindle.index_tick;
+    } while (count != en.spindle.index_count);
+
+    float rev_ms = en.spindle.rev_ms;
+    float fraction = 0;
+    if (!fp_ZERO(rev_ms)) {
+        fraction = (float)(SysTickTimer_getValue() - tick) / rev_ms;
+        fraction = std::min(fraction, (float)0.999);
+    }
+    return ((float)(count - en.spindle.ref_count) + fraction);
+}
+
 /***********************************************************************************
  * CONFIGURATION AND INTERFACE FUNCTIONS
  * Functions to get and set variables from the cfgArray table
@@ -93,6 +93,9 @@
 
 /**** Configs and Constants ****/
 
+#define SPINDLE_INDEX_TIMEOUT_MS    2000    // no index pulse for this long means the spindle is stopped (30 RPM)
+#define SPINDLE_INDEX_FILTER        0.5     // weight given to each new revolution period
+
 /**** Macros ****/
 // used to abstract the encoder code out of the stepper so it can be managed in one place
 
@@ -105,15 +108,24 @@
 /**** Structures ****/
 
 typedef struct enEncoder {          // one real or virtual encoder per controlled motor
-    int8_t  step_sign;              // set to +1 or -1
-    int16_t steps_run;              // + or - steps counted during stepper interrupt
+    int16_t step_sign;              // set to +1 or -1, times the pulse weight when microsteps are coarsened
+    int32_t steps_run;              // + or - steps counted during stepper interrupt
     int32_t encoder_steps;          // counted encoder position	in steps
 } enEncoder_t;
 
+typedef struct enSpindleIndex {     // once-per-revolution spindle index used by G33
+    volatile uint32_t index_tick;   // SysTick time of the latest index pulse
+    volatile uint32_t index_count;  // index pulses seen since reset
+    volatile float rev_ms;          // filtered revolution period, 0 until measured
+    volatile bool armed;            // take the phase reference at the next index pulse
+    volatile uint32_t ref_count;    // index count at the phase reference
+} enSpindleIndex_t;
+
 typedef struct enEncoders {
     magic_t     magic_start;
     enEncoder_t en[MOTORS];         // runtime encoder structures
     float       snapshot[MOTORS];   // snapshot vector
+    enSpindleIndex_t spindle;       // spindle index measurement
     magic_t     magic_end;
 } enEncoders_t;
 
@@ -134,4 +146,10 @@ void en_take_encoder_snapshot();
 float en_get_encoder_snapshot_steps(uint8_t motor);
 float* en_get_encoder_snapshot_vector();
 
+void en_spindle_index(void);
+void en_spindle_arm(void);
+bool en_spindle_is_referenced(void);
+float en_spindle_rpm(void);
+float en_spindle_revolutions(void);
+
 #endif  // End of include guard: ENCODER_H_ONCE
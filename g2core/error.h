@@ -277,14 +277,14 @@ char *get_status_message(stat_t status);
 
 #define STAT_T_WORD_IS_MISSING 180
 #define STAT_T_WORD_IS_INVALID 181
+#define STAT_K_WORD_IS_MISSING 182                  // G33 requires a K thread pitch
+#define STAT_K_WORD_IS_INVALID 183
+#define STAT_SPINDLE_INDEX_NOT_FOUND 184            // no spindle index input is configured, or no index pulse was seen
 
 /* reserved for Gcode or other program errors */
 
-#define STAT_ERROR_182 182
-#define STAT_ERROR_183 183
-#define STAT_ERROR_184 184
-#define STAT_ERROR_185 185
-#define STAT_ERROR_186 186
+#define STAT_INVERSE_TIME_NOT_MET 185              // G93 block(s) could not be run in the programmed time
+#define STAT_SPINDLE_SYNC_LOST 186                 // G33 spindle speed went outside the range the axes can follow
 #define STAT_ERROR_187 187
 #define STAT_ERROR_188 188
 #define STAT_ERROR_189 189
@@ -357,7 +357,7 @@ char *get_status_message(stat_t status);
 #define STAT_HOMING_ERROR_HOMING_INPUT_MISCONFIGURED 246
 #define STAT_HOMING_ERROR_MUST_CLEAR_SWITCHES_BEFORE_HOMING 247
 #define STAT_ERROR_248 248
-#define STAT_ERROR_249 249
+#define STAT_PROBE_SAMPLES_INCONSISTENT 249
 
 #define STAT_PROBE_CYCLE_FAILED 250             // probing cycle did not complete
 #define STAT_PROBE_TRAVEL_TOO_SMALL 251
@@ -573,11 +573,11 @@ static const char stat_179[] = "S word invalid";
 
 static const char stat_180[] = "T word missing";
 static const char stat_181[] = "T word invalid";
-static const char stat_182[] = "182";
-static const char stat_183[] = "183";
-static const char stat_184[] = "184";
-static const char stat_185[] = "185";
-static const char stat_186[] = "186";
+static const char stat_182[] = "K word missing";
+static const char stat_183[] = "K word invalid";
+static const char stat_184[] = "Spindle index not found";
+static const char stat_185[] = "G93 inverse time not met";
+static const char stat_186[] = "G33 spindle sync lost";
 static const char stat_187[] = "187";
 static const char stat_188[] = "188";
 static const char stat_189[] = "189";
@@ -646,7 +646,7 @@ static const char stat_245[] = "245";
 static const char stat_246[] = "Homing Err - Homing input is misconfigured";
 static const char stat_247[] = "Homing Err - Must clear switches before homing";
 static const char stat_248[] = "248";
-static const char stat_249[] = "249";
+static const char stat_249[] = "Probe samples are inconsistent";
 
 static const char stat_250[] = "Probe cycle failed";
 static const char stat_251[] = "Probe travel is too small";
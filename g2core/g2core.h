@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <atomic>                   // counters shared between interrupts and the main loop
 
 #include "MotatePins.h"             // comment in if Motate / ARM
 #include "error.h"                  // Status code definitions and strings
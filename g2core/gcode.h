@@ -39,7 +39,8 @@ typedef enum {                          // G Modal Group 1
     MOTION_MODE_CANNED_CYCLE_86,        // G86 - boring, spindle stop, rapid out
     MOTION_MODE_CANNED_CYCLE_87,        // G87 - back boring
     MOTION_MODE_CANNED_CYCLE_88,        // G88 - boring, spindle stop, manual out
-    MOTION_MODE_CANNED_CYCLE_89         // G89 - boring, dwell, feed out
+    MOTION_MODE_CANNED_CYCLE_89,        // G89 - boring, dwell, feed out
+    MOTION_MODE_SPINDLE_SYNC            // G33 - spindle synchronized motion
 } cmMotionMode;
 
 typedef enum {              // canonical plane - translates to:
@@ -161,7 +162,7 @@ typedef enum {              // axis modes (ordered: see _cm_get_feed_time())
 typedef struct GCodeState {             // Gcode model state - used by model, planning and runtime
     int32_t linenum;                    // Gcode block line number
     cmMotionMode motion_mode;           // Group1: G0, G1, G2, G3, G38.2, G80, G81, G82
-                                        //         G83, G84, G85, G86, G87, G88, G89
+                                        //         G83, G84, G85, G86, G87, G88, G89, G33
 
     float target[AXES];                 // XYZABC target where the move should go
     float target_comp[AXES];            // summation compensation (Kahan) overflow value
@@ -169,6 +170,7 @@ typedef struct GCodeState {             // Gcode model state - used by model, pl
 
     float feed_rate;                    // F - normalized to millimeters/minute or in inverse time mode
     float P_word;                       // P - parameter used for dwell time in seconds, G10 coord select...
+    float spindle_sync_pitch;           // G33 path travel per spindle revolution (mm), 0 if not synchronized
 
     cmFeedRateMode feed_rate_mode;      // See cmFeedRateMode for settings
     cmCanonicalPlane select_plane;      // G17,G18,G19 - values to set plane to
@@ -192,6 +194,7 @@ typedef struct GCodeState {             // Gcode model state - used by model, pl
 
         feed_rate = 0.0;
         P_word = 0.0;
+        spindle_sync_pitch = 0.0;
 
         feed_rate_mode = INVERSE_TIME_MODE;
         select_plane = CANON_PLANE_XY;
@@ -218,6 +221,7 @@ typedef struct GCodeStateExtended {     // Gcode dynamic state extensions - used
     float g28_position[AXES];           // XYZABC stored machine position for G28
     float g30_position[AXES];           // XYZABC stored machine position for G30
     float p1_position[AXES];            // XYZABC stored machine position for return to p1 planner
+    float spindle_speed;                // S word as last programmed (queued), used to plan G33
 
     bool m48_enable;                    // master feedrate / spindle speed override enable
     bool mfo_enable;                    // feedrate override enable
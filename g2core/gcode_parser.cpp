@@ -27,6 +27,7 @@
 #include "coolant.h"
 #include "util.h"
 #include "xio.h"                    // for char definitions
+#include "report.h"
 
 #if MARLIN_COMPAT_ENABLED == true
 #include "marlin_compatibility.h"
@@ -41,7 +42,7 @@ static stat_t _execute_gcode_block_marlin(void);
 
 typedef enum {                          // Used for detecting gcode errors. See NIST section 3.4
     MODAL_GROUP_G0 = 0,                 // {G10,G28,G28.1,G92}  non-modal axis commands (note 1)
-    MODAL_GROUP_G1,                     // {G0,G1,G2,G3,G80}    motion
+    MODAL_GROUP_G1,                     // {G0,G1,G2,G3,G33,G80} motion
     MODAL_GROUP_G2,                     // {G17,G18,G19}        plane selection
     MODAL_GROUP_G3,                     // {G90,G91}            distance mode
     MODAL_GROUP_G5,                     // {G93,G94}            feed rate mode
@@ -76,6 +77,7 @@ typedef enum {                                  // these are in order to optimiz
     NEXT_ACTION_HOMING_NO_SET,                  // G28.4 homing cycle with no coordinate setting
     NEXT_ACTION_GOTO_G30_POSITION,              // G30 go to machine position
     NEXT_ACTION_SET_G30_POSITION,               // G30.1 set position in abs coordinates
+    NEXT_ACTION_TOOL_MEASURE,                   // G37
     NEXT_ACTION_STRAIGHT_PROBE_ERR,             // G38.2
     NEXT_ACTION_STRAIGHT_PROBE,                 // G38.3
     NEXT_ACTION_STRAIGHT_PROBE_AWAY_ERR,        // G38.4
@@ -90,6 +92,7 @@ typedef enum {                                  // these are in order to optimiz
     NEXT_ACTION_JSON_COMMAND_SYNC,              // M100
     NEXT_ACTION_JSON_COMMAND_ASYNC,             // M100.1
     NEXT_ACTION_JSON_WAIT,                      // M101
+    NEXT_ACTION_WAIT_ON_INPUT,                  // M66
 
 #if MARLIN_COMPAT_ENABLED == true               // supported Marlin Gcode and M codes. Also E
     NEXT_ACTION_MARLIN_TRAM_BED,                // G29
@@ -115,7 +118,7 @@ typedef enum {                                  // these are in order to optimiz
 typedef struct GCodeInputValue {    // Gcode inputs - meaning depends on context
 
     gpNextAction next_action;       // handles G modal group 1 moves & non-modals
-    cmMotionMode motion_mode;       // Group1: G0, G1, G2, G3, G38.2, G80, G81, G82, G83, G84, G85, G86, G87, G88, G89
+    cmMotionMode motion_mode;       // Group1: G0, G1, G2, G3, G38.2, G80, G81, G82, G83, G84, G85, G86, G87, G88, G89, G33
     uint8_t program_flow;           // used only by the gcode_parser
     uint32_t linenum;               // gcode N word
 
@@ -126,7 +129,8 @@ typedef struct GCodeInputValue {    // Gcode inputs - meaning depends on context
     float P_word;                   // P word - parameter used for dwell time in seconds, G10 commands
     float S_word;                   // S word - usually in RPM
     uint8_t H_word;                 // H word - used by G43s
-    uint8_t L_word;                 // L word - used by G10s
+    uint8_t L_word;                 // L word - used by G10s, M66
+    float Q_word;                   // Q word - M66 timeout in seconds
 
     uint8_t feed_rate_mode;         // See cmFeedRateMode for settings
     uint8_t select_plane;           // G17,G18,G19 - values to set plane to
@@ -174,6 +178,7 @@ typedef struct GCodeFlags {         // Gcode input flags
     bool S_word;
     bool H_word;
     bool L_word;
+    bool Q_word;
 
     bool feed_rate_mode;
     bool select_plane;
@@ -256,6 +261,7 @@ stat_t gcode_parser(char *block)
     if (check_ret != STAT_OK) {
         return check_ret;
     }
+    jp.lines_consumed++;                    // count lines for job progress (comments count as lines)
 
     _normalize_gcode_block(str, &active_comment, &block_delete_flag);
 
@@ -707,6 +713,14 @@ static stat_t _parse_gcode_block(char *buf, char *active_comment)
                     }
                     break;
                 }
+                case 33: {
+                    switch (_point(value)) {
+                        case 0: SET_MODAL (MODAL_GROUP_G1, motion_mode, MOTION_MODE_SPINDLE_SYNC);
+                        default: status = STAT_GCODE_COMMAND_UNSUPPORTED;   // G33.1 needs a direction-sensing spindle
+                    }
+                    break;
+                }
+                case 37: SET_NON_MODAL (next_action, NEXT_ACTION_TOOL_MEASURE);
                 case 38: {
                     switch (_point(value)) {
                         case 2: SET_NON_MODAL (next_action, NEXT_ACTION_STRAIGHT_PROBE_ERR);
@@ -801,6 +815,7 @@ static stat_t _parse_gcode_block(char *buf, char *active_comment)
                     }
                     break;
                 case 51: SET_MODAL (MODAL_GROUP_M9, spo_control, true);
+                case 66: SET_NON_MODAL (next_action, NEXT_ACTION_WAIT_ON_INPUT);
                 case 100:
                     switch (_point(value)) {
                         case 0: SET_NON_MODAL (next_action, NEXT_ACTION_JSON_COMMAND_SYNC);
@@ -864,6 +879,7 @@ static stat_t _parse_gcode_block(char *buf, char *active_comment)
             case 'J': SET_NON_MODAL (arc_offset[1], value);
             case 'K': SET_NON_MODAL (arc_offset[2], value);
             case 'L': SET_NON_MODAL (L_word, value);
+            case 'Q': SET_NON_MODAL (Q_word, value);
             case 'R': SET_NON_MODAL (arc_radius, value);
             case 'N': SET_NON_MODAL (linenum, value_int);           // line number handled as special case to preserve integer value
             
@@ -1015,6 +1031,7 @@ stat_t _execute_gcode_block(char *active_comment)
         case NEXT_ACTION_STRAIGHT_PROBE:         { status = cm_straight_probe(gv.target, gf.target, true, false); break;} // G38.3
         case NEXT_ACTION_STRAIGHT_PROBE_AWAY_ERR:{ status = cm_straight_probe(gv.target, gf.target, false, true); break;} // G38.4
         case NEXT_ACTION_STRAIGHT_PROBE_AWAY:    { status = cm_straight_probe(gv.target, gf.target, false, false); break;}// G38.5
+        case NEXT_ACTION_TOOL_MEASURE:           { status = cm_tool_measure_cycle(gv.target, gf.target); break;}          // G37
 
         case NEXT_ACTION_SET_G10_DATA:           { status = cm_set_g10_data(gv.P_word, gf.P_word,               // G10
                                                                             gv.L_word, gf.L_word,
@@ -1028,6 +1045,7 @@ stat_t _execute_gcode_block(char *active_comment)
         case NEXT_ACTION_JSON_COMMAND_SYNC:       { status = cm_json_command(active_comment); break;}               // M100.0
         case NEXT_ACTION_JSON_COMMAND_ASYNC:      { status = cm_json_command_immediate(active_comment); break;}     // M100.1
         case NEXT_ACTION_JSON_WAIT:               { status = cm_json_wait(active_comment); break;}                  // M101
+        case NEXT_ACTION_WAIT_ON_INPUT:           { status = cm_wait_on_input(gv.P_word, gf.P_word, gv.L_word, gv.Q_word); break;} // M66
         
         case NEXT_ACTION_DEFAULT: {
             cm_set_absolute_override(MODEL, gv.absolute_override); // apply absolute override & display as absolute
@@ -1044,6 +1062,10 @@ stat_t _execute_gcode_block(char *active_comment)
                                                                  gv.motion_mode);
                                             break;
                                           }
+                case MOTION_MODE_SPINDLE_SYNC: { status = cm_spindle_sync_feed(gv.target, gf.target,                // G33
+                                                                               gv.arc_offset[2], gf.arc_offset[2]);
+                                                 break;
+                                               }
                 default: break;
             }
             cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_OFF);  // un-set absolute override once the move is planned
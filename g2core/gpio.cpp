@@ -47,6 +47,7 @@
 #include "encoder.h"
 #include "hardware.h"
 #include "canonical_machine.h"
+#include "planner.h"
 
 #include "text_parser.h"
 #include "controller.h"
@@ -139,6 +140,13 @@ struct ioDigitalInputExt {
         } else {
             in->edge = INPUT_EDGE_TRAILING;
         }
+        if ((in->function == INPUT_FUNCTION_SPINDLE_INDEX) && (in->edge == INPUT_EDGE_LEADING)) {
+            en_spindle_index();                     // must precede releasing a G33 index wait
+        }
+        mp_input_changed(ext_pin_number, (in->edge == INPUT_EDGE_LEADING));   // release any input wait
+        if (in->function == INPUT_FUNCTION_SPINDLE_INDEX) {
+            return;                                 // index pulses are too frequent for status reports
+        }
 
         // perform homing operations if in homing mode
         if (in->homing_mode) {
@@ -466,6 +474,16 @@ int8_t gpio_get_probing_input(void)
     return (-1);
 }
 
+uint8_t gpio_get_spindle_index_input(void)
+{
+    for (uint8_t i = 1; i <= D_IN_CHANNELS; i++) {
+        if ((d_in[i-1].function == INPUT_FUNCTION_SPINDLE_INDEX) && (d_in[i-1].mode != IO_MODE_DISABLED)) {
+            return (i);
+        }
+    }
+    return (0);
+}
+
 bool gpio_read_input(const uint8_t input_num_ext)
 {
     if (input_num_ext == 0) {
@@ -674,7 +692,7 @@ stat_t io_set_output(nvObj_t *nv)
 
     static const char fmt_gpio_mo[] = "[%smo] input mode%17d [0=active-low,1=active-hi,2=disabled]\n";
     static const char fmt_gpio_ac[] = "[%sac] input action%15d [0=none,1=stop,2=fast_stop,3=halt,4=alarm,5=shutdown,6=panic,7=reset]\n";
-    static const char fmt_gpio_fn[] = "[%sfn] input function%13d [0=none,1=limit,2=interlock,3=shutdown,4=probe]\n";
+    static const char fmt_gpio_fn[] = "[%sfn] input function%13d [0=none,1=limit,2=interlock,3=shutdown,4=probe,5=spindle index]\n";
     static const char fmt_gpio_in[] = "Input %s state: %5d\n";
 
     static const char fmt_gpio_domode[] = "[%smo] output mode%16d [0=active low,1=active high,2=disabled]\n";
@@ -88,9 +88,10 @@ typedef enum {                          // functions are requested from the ISR,
     INPUT_FUNCTION_LIMIT = 1,           // limit switch processing
     INPUT_FUNCTION_INTERLOCK = 2,       // interlock processing
     INPUT_FUNCTION_SHUTDOWN = 3,        // shutdown in support of external emergency stop
-    INPUT_FUNCTION_PROBE = 4            // assign input as probe input
+    INPUT_FUNCTION_PROBE = 4,           // assign input as probe input
+    INPUT_FUNCTION_SPINDLE_INDEX = 5    // once-per-revolution spindle index pulse (G33)
 } inputFunc;
-#define INPUT_FUNCTION_MAX  INPUT_FUNCTION_PROBE
+#define INPUT_FUNCTION_MAX  INPUT_FUNCTION_SPINDLE_INDEX
 
 typedef enum {
     INPUT_INACTIVE = 0,                 // aka switch open, also read as 'false'
@@ -149,6 +150,7 @@ void output_reset(void);
 void gpio_set_homing_mode(const uint8_t input_num, const bool is_homing);
 void gpio_set_probing_mode(const uint8_t input_num, const bool is_probing);
 int8_t gpio_get_probing_input(void);
+uint8_t gpio_get_spindle_index_input(void);
 bool gpio_read_input(const uint8_t input_num);
 stat_t gpio_set_output(uint8_t output_num, float value);
 
@@ -21,16 +21,69 @@
 #include "config.h"  // #2
 #include "report.h"
 #include "help.h"
+#include "text_parser.h"
 #include "xio.h"
 
 // help helper functions (snicker)
 
 stat_t help_stub(nvObj_t* nv) { return (STAT_OK); }
+stat_t help_screen_callback_stub() { return (STAT_NOOP); }
+bool help_screen_active_stub() { return (false); }
 
 #if defined(__TEXT_MODE) && defined(__HELP_SCREENS)
 
+/*
+ * Help screens are more output than the TX queue holds, so the help functions only queue
+ * their sections. help_screen_callback() writes a section per main loop pass once the host
+ * has caught up, and holds off new commands until the screen is done.
+ */
+#define HELP_SECTIONS 6                     // most sections a help screen has
+
+static struct helpScreen {
+    const char *section[HELP_SECTIONS];     // text to write, in order (string literals)
+    uint8_t count;                          // number of sections queued
+    uint8_t cursor;                         // next section to write
+    bool system_ready;                      // end with the system ready message
+} hs;
+
+static void _help_add(const char *text) {
+    if (hs.count < HELP_SECTIONS) {
+        hs.section[hs.count++] = text;
+    }
+}
+
+bool help_screen_active() { return (hs.cursor < hs.count); }
+
+stat_t help_screen_callback() {
+    if (!help_screen_active()) {
+        return (STAT_NOOP);
+    }
+    if (!xio_connected()) {                     // nobody to show it to
+        hs.count = 0;
+        hs.cursor = 0;
+        hs.system_ready = false;
+        return (STAT_NOOP);
+    }
+    if (xio_tx_backed_up()) {                   // wait for the host to catch up
+        return (STAT_EAGAIN);
+    }
+    xio_writeline(hs.section[hs.cursor++]);
+    if (help_screen_active()) {
+        return (STAT_EAGAIN);                   // more to send
+    }
+    hs.count = 0;
+    hs.cursor = 0;
+    if (hs.system_ready) {
+        hs.system_ready = false;
+        rpt_print_system_ready_message();       // includes the prompt
+    } else {
+        text_response(STAT_OK, (char *)"");     // the prompt held back by the controller
+    }
+    return (STAT_OK);
+}
+
 static void _status_report_advisory() {
-    xio_writeline(
+    _help_add(
         "\n\
 Note: g2core generates automatic status reports by default\n\
 This can be disabled by entering $sv=0\n\
@@ -39,7 +92,7 @@ See the wiki below for more details.\n\
 }
 
 static void _postscript() {
-    xio_writeline(
+    _help_add(
         "\n\
 For detailed g2core info see: https://github.com/synthetos/g2/wiki\n\
 For the latest firmware see: https://github.com/synthetos/g2\n\
@@ -51,8 +104,8 @@ Have fun\n");
  * help_general() - help invoked as h from the command line
  */
 uint8_t help_general(nvObj_t* nv) {
-    xio_writeline("\n\n\n### g2core Help ###\n");
-    xio_writeline(
+    _help_add("\n\n\n### g2core Help ###\n");
+    _help_add(
         "\n\
 These commands are active from the command line:\n\
  ^x             Reset (control x) - software reset\n\
@@ -69,7 +122,7 @@ These commands are active from the command line:\n\
 ");
     _status_report_advisory();
     _postscript();
-    rpt_print_system_ready_message();
+    hs.system_ready = true;                 // end with the system ready message
     return (STAT_OK);
 }
 
@@ -77,8 +130,8 @@ These commands are active from the command line:\n\
  * help_config() - help invoked as $h
  */
 stat_t help_config(nvObj_t* nv) {
-    xio_writeline("\n\n\n### g2core CONFIGURATION Help ###\n");
-    xio_writeline(
+    _help_add("\n\n\n### g2core CONFIGURATION Help ###\n");
+    _help_add(
         "\n\
 These commands are active for configuration:\n\
   $sys Show system (general) settings\n\
@@ -90,7 +143,7 @@ These commands are active for configuration:\n\
   $$   Show all settings\n\
   $h   Show this help screen\n\n\
 ");
-    xio_writeline(
+    _help_add(
         "\n\
 Each $ command above also displays the token for each setting in [ ] brackets\n\
 To view settings enter a token:\n\n\
@@ -110,8 +163,8 @@ For configuration details see: https://github.com/synthetos/g2/wiki/g2-Configura
  * help_defa() - help invoked for defaults
  */
 stat_t help_defa(nvObj_t* nv) {
-    xio_writeline("\n\n\n### g2core RESTORE DEFAULTS Help ###\n");
-    xio_writeline(
+    _help_add("\n\n\n### g2core RESTORE DEFAULTS Help ###\n");
+    _help_add(
         "\n\
 Enter $defa=1 to reset the system to the factory default values.\n\
 This will overwrite any changes you have made.\n");
@@ -123,8 +176,8 @@ This will overwrite any changes you have made.\n");
  * help_flash()
  */
 stat_t help_flash(nvObj_t* nv) {
-    xio_writeline("\n\n\n### g2core FLASH LOADER Help ###\n");
-    xio_writeline(
+    _help_add("\n\n\n### g2core FLASH LOADER Help ###\n");
+    _help_add(
         "\n\
 Enter $flash=1 to enter the flash loader.\n");
     _postscript();
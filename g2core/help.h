@@ -28,6 +28,9 @@ stat_t help_test(nvObj_t* nv);
 stat_t help_defa(nvObj_t* nv);
 stat_t help_flash(nvObj_t* nv);
 
+bool help_screen_active(void);
+stat_t help_screen_callback(void);
+
 #else
 
 stat_t help_stub(nvObj_t* nv);
@@ -37,6 +40,11 @@ stat_t help_stub(nvObj_t* nv);
 #define help_defa help_stub
 #define help_flash help_stub
 
+stat_t help_screen_callback_stub(void);
+bool help_screen_active_stub(void);
+#define help_screen_callback help_screen_callback_stub
+#define help_screen_active help_screen_active_stub
+
 #endif
 
 #endif  // End of include guard: HELP_H_ONCE
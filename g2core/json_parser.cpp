@@ -112,6 +112,13 @@ void json_parse_for_exec(char *str, bool execute)
     }
 }
 
+// Parse into the queue list so the command can be compiled into a planner record. Does not execute.
+stat_t json_parse_for_queue(char *str)
+{
+    nvObj_t *nv = nv_reset_queue_nv_list();         // get a fresh nvObj list
+    return (_json_parser_kernal(nv, str));
+}
+
 static stat_t _json_parser_execute(nvObj_t *nv) {
 
     do {
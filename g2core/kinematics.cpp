@@ -36,67 +36,68 @@
 static void _inverse_kinematics(const float travel[], float joint[]);
 
 /*
- * kn_kinematics() - wrapper routine for inverse kinematics
+ * Axis-to-motor projection
  *
- *	Calls kinematics function(s).
- *	Performs axis mapping & conversion of length units to steps (and deals with inhibited axes)
- *
- *	The reason steps are returned as floats (as opposed to, say, uint32_t) is to accommodate
- *	fractional DDA steps. The DDA deals with fractional step values as fixed-point binary in
- *	order to get the smoothest possible operation. Steps are passed to the move prep routine
- *	as floats and converted to fixed-point binary during queue loading. See stepper.c for details.
+ *  The motor map, steps per unit and axis modes are constant for the duration of a block,
+ *  so the mapping of joints onto motors is reduced to a compact list of (motor, axis, scale)
+ *  entries once per block. Motors that are unmapped or mapped to an inhibited axis are left
+ *  out of the list and their step values are not written, exactly as before.
  */
 
-void kn_inverse_kinematics(const float travel[], float steps[]) {
-    float joint[AXES];
+typedef struct knProjection {
+    uint8_t count;                      // number of active entries
+    uint8_t motor[MOTORS];              // motor to write
+    uint8_t axis[MOTORS];               // joint that drives it
+    float steps_per_unit[MOTORS];       // scale from joint units to steps
+} knProjection_t;
 
-    _inverse_kinematics(travel, joint);  // insert inverse kinematics transformations here
+static knProjection_t kp;
 
-// We'll time-test each and see if unrolling is worth it.
-#if 0
-    // Map motors to axes and convert length units to steps
-    // Most of the conversion math has already been done in during config in steps_per_unit()
-    // which takes axis travel, step angle and microsteps into account.
-    for (uint8_t axis=0; axis<AXES; axis++) {
-        if (cm->a[axis].axis_mode == AXIS_INHIBITED) { joint[axis] = 0;}
-        if (st_cfg.mot[MOTOR_1].motor_map == axis) {
-            steps[MOTOR_1] = joint[axis] * st_cfg.mot[MOTOR_1].steps_per_unit;
-        }
-        if (st_cfg.mot[MOTOR_2].motor_map == axis) {
-            steps[MOTOR_2] = joint[axis] * st_cfg.mot[MOTOR_2].steps_per_unit;
-        }
-        if (st_cfg.mot[MOTOR_3].motor_map == axis) {
-            steps[MOTOR_3] = joint[axis] * st_cfg.mot[MOTOR_3].steps_per_unit;
-        }
-        if (st_cfg.mot[MOTOR_4].motor_map == axis) {
-            steps[MOTOR_4] = joint[axis] * st_cfg.mot[MOTOR_4].steps_per_unit;
-        }
-#if (MOTORS >= 5)
-        if (st_cfg.mot[MOTOR_5].motor_map == axis) {
-            steps[MOTOR_5] = joint[axis] * st_cfg.mot[MOTOR_5].steps_per_unit;
-        }
-#endif
-#if (MOTORS >= 6)
-        if (st_cfg.mot[MOTOR_6].motor_map == axis) {
-            steps[MOTOR_6] = joint[axis] * st_cfg.mot[MOTOR_6].steps_per_unit;
-        }
-#endif
-    }
-
-#else
+/*
+ * kn_load_projection() - build the axis-to-motor projection from the current config
+ *
+ *  Called when a new block is loaded in mp_exec_aline() and whenever the runtime
+ *  step position is reset, so config changes take effect at the next block.
+ */
 
+void kn_load_projection() {
+    kp.count = 0;
     for (uint8_t axis = 0; axis < AXES; axis++) {
         if (cm->a[axis].axis_mode == AXIS_INHIBITED) {
-            joint[axis] = 0;
             continue;
         }
         for (uint8_t motor = 0; motor < MOTORS; motor++) {
             if (st_cfg.mot[motor].motor_map == axis) {
-                steps[motor] = joint[axis] * st_cfg.mot[motor].steps_per_unit;
+                kp.motor[kp.count] = motor;
+                kp.axis[kp.count] = axis;
+                kp.steps_per_unit[kp.count] = st_cfg.mot[motor].steps_per_unit;
+                kp.count++;
             }
         }
     }
-#endif
+}
+
+/*
+ * kn_inverse_kinematics() - wrapper routine for inverse kinematics
+ *
+ *	Calls kinematics function(s).
+ *	Performs axis mapping & conversion of length units to steps using the projection
+ *	loaded by kn_load_projection() (which deals with inhibited axes)
+ *
+ *	The reason steps are returned as floats (as opposed to, say, uint32_t) is to accommodate
+ *	fractional DDA steps. The DDA deals with fractional step values as fixed-point binary in
+ *	order to get the smoothest possible operation. Steps are passed to the move prep routine
+ *	as floats and converted to fixed-point binary during queue loading. See stepper.c for details.
+ */
+
+void kn_inverse_kinematics(const float travel[], float steps[]) {
+    float joint[AXES];
+
+    _inverse_kinematics(travel, joint);  // insert inverse kinematics transformations here
+
+    for (uint8_t i = 0; i < kp.count; i++) {
+        steps[kp.motor[i]] = joint[kp.axis[i]] * kp.steps_per_unit[i];
+    }
 }
 
 /*
@@ -32,6 +32,7 @@
  * Global Scope Functions
  */
 
+void kn_load_projection(void);
 void kn_inverse_kinematics(const float travel[], float steps[]);
 void kn_forward_kinematics(const float steps[], float travel[]);
 
@@ -68,6 +68,7 @@ MarlinStateExtended_t mst;       // Marlin state object
 
 bool temperature_requested = false;
 bool position_requested = false;
+bool resend_requested = false;      // true from a "Resend:" until a line is accepted again
 
 // State machine to handle marlin temperature controls
 enum class MarlinSetTempState {
@@ -148,6 +149,26 @@ void _report_position(char *(&str)) {
     }
 }
 
+/***********************************************************************************
+ * _report_advanced_ok() - convenience function called from marlin_response()
+ *
+ *  Appends the Marlin ADVANCED_OK fields: the last accepted line number, the free planner
+ *  buffers, and the free RX line slots. Senders use P and B to keep several lines in flight
+ *  instead of waiting for each "ok" in turn. The slot count is how many lines of
+ *  MARLIN_RX_LINE_LENGTH the RX buffers hold, less the lines already waiting in them.
+ */
+void _report_advanced_ok(char *(&str)) {
+    uint16_t lines_queued = xio_get_rx_lines_queued();
+    uint16_t line_slots = xio_get_rx_line_slots();
+
+    str_concat(str, " N");
+    str += inttoa(str, cm->gmx.last_line_number);
+    str_concat(str, " P");
+    str += inttoa(str, mp_get_planner_buffers(mp));
+    str_concat(str, " B");
+    str += inttoa(str, (lines_queued < line_slots) ? (line_slots - lines_queued) : 0);
+}
+
 /***********************************************************************************
  *** MARLIN GCODES AND MCODES
  *** Called from gcore_parser.cpp
@@ -488,6 +509,14 @@ stat_t marlin_callback()
 
 /***********************************************************************************
  * marlin_response() - marlin mirror of text_response(), called from _dispatch_kernel() in controller.cpp
+ *
+ *  Resend handling: a checksum failure or out-of-sequence line number prints an error and
+ *  "Resend: <last+1>". Senders that keep several lines in flight (advanced ok) will have more
+ *  lines already on the wire at that point. Those arrive out of sequence and are dropped,
+ *  but each one is answered with the same "Resend: <last+1>" (without repeating the error)
+ *  so a sender that missed the first request still gets one and can't stall waiting for an
+ *  "ok". Checksum failures always report the error and ask for the resend, as the line
+ *  number of a corrupted line can't be trusted.
  */
 void marlin_response(const stat_t status, char *buf)
 {
@@ -501,6 +530,7 @@ void marlin_response(const stat_t status, char *buf)
     }
 
     if ((status == STAT_OK) || (status == STAT_EAGAIN) || (status == STAT_NOOP)) {
+        resend_requested = false;                   // the sender is back in sequence
         str_concat(str, "ok");
 
         if (temperature_requested) {
@@ -511,6 +541,10 @@ void marlin_response(const stat_t status, char *buf)
             _report_position(str);
         }
 
+        if (MARLIN_ADVANCED_OK) {
+            _report_advanced_ok(str);
+        }
+
 //        nvObj_t *nv = nv_body+1;
 //
 //        if (nv_get_type(nv) == NV_TYPE_MESSAGE) {
@@ -525,25 +559,29 @@ void marlin_response(const stat_t status, char *buf)
         request_resend = true;
     }
     else if (status == STAT_LINE_NUMBER_OUT_OF_SEQUENCE) {
-        str_concat(str, "Error:Line Number is not Last Line Number+1, Last Line: ");
-        str += inttoa(str, cm->gmx.last_line_number);
         request_resend = true;
+        if (!resend_requested) {                    // otherwise it was in flight when the resend went out
+            str_concat(str, "Error:Line Number is not Last Line Number+1, Last Line: ");
+            str += inttoa(str, cm->gmx.last_line_number);
+        }
     }
     else {
         str += sprintf(str, "Error:%s", get_status_message(status));
     }
 
-    *str++ = '\n';
-    *str++ = 0;
-
     // reset requests
     temperature_requested = false;
     position_requested = false;
 
-    xio_writeline(buffer);
+    if (str != buffer) {                            // empty if only the resend goes out
+        *str++ = '\n';
+        *str++ = 0;
+        xio_writeline(buffer);
+    }
 
 
     if (request_resend) {
+        resend_requested = true;
         str = buffer;
         str_concat(str, "Resend: ");
         str += inttoa(str, cm->gmx.last_line_number+1);
@@ -28,6 +28,8 @@
 
 static stat_t _compute_arc(const bool radius_f);
 static void _compute_arc_offsets_from_radius(void);
+static float _max_abs_cos(const float theta, const float travel);
+static void _limit_arc_feed_rate(void);
 static float _estimate_arc_time (float arc_time);
 static stat_t _test_arc_soft_limits(void);
 
@@ -340,6 +342,9 @@ static stat_t _compute_arc(const bool radius_f)
     cm->arc.planar_travel = cm->arc.angular_travel * cm->arc.radius;
     cm->arc.length = hypotf(cm->arc.planar_travel, fabs(cm->arc.linear_travel));
 
+    // Slow the arc down if the plane axes can't follow it at the requested feed rate
+    _limit_arc_feed_rate();
+
     // Find the minimum number of segments that meet accuracy and time constraints...
     // Note: removed segment_length test as segment_time accounts for this (build 083.37)
     float arc_time;
@@ -477,15 +482,70 @@ static void _compute_arc_offsets_from_radius()
     cm->arc.ijk_offset[cm->arc.linear_axis] = 0;
 }
 
+/*
+ * _max_abs_cos() - largest |cos| over the angular span from theta to theta + travel
+ *
+ *  Plane axis 0 moves at the planar rate scaled by cos(theta) and plane axis 1 by
+ *  sin(theta), so this gives the peak share of the planar rate (and jerk) an axis
+ *  sees over an arc. Pass theta - PI/2 for |sin|. |cos| peaks at 1 on multiples
+ *  of PI; otherwise the peak is at one of the ends of the span.
+ */
+static float _max_abs_cos(const float theta, const float travel)
+{
+    float lo = min(theta, theta + travel);
+    float hi = max(theta, theta + travel);
+
+    if ((hi - lo >= M_PI) || (ceil(lo / M_PI) * M_PI <= hi)) {
+        return (1.0);
+    }
+    return (max(fabs(cos(lo)), fabs(cos(hi))));
+}
+
+/*
+ * _limit_arc_feed_rate() - cap the arc feed rate by what the plane axes can follow
+ *
+ *  At planar velocity v on radius r the centripetal acceleration is v^2/r, and it
+ *  turns at v/r, so the plane axes see a jerk of v^3/r^2 scaled by their peak
+ *  |cos| or |sin| over the arc. There are no acceleration limits to test against,
+ *  but the jerk limits bound it:
+ *
+ *      v <= cbrt(jerk * r^2 / peak)
+ *
+ *  The segments are planned as independent lines, so without this small circles
+ *  are run at feeds the axes can't follow. Large radius arcs are unaffected.
+ */
+static void _limit_arc_feed_rate()
+{
+    float planar_travel = fabs(cm->arc.planar_travel);
+    if (fp_ZERO(planar_travel)) {
+        return;
+    }
+    float r2 = cm->arc.radius * cm->arc.radius;
+    float peak[2] = { _max_abs_cos(cm->arc.theta, cm->arc.angular_travel),
+                      _max_abs_cos(cm->arc.theta - M_PI/2, cm->arc.angular_travel) };
+    cmAxes axis[2] = { cm->arc.plane_axis_0, cm->arc.plane_axis_1 };
+
+    float planar_velocity = 8675309;        // velocity in the plane the axes allow (mm/min)
+    for (uint8_t i=0; i<2; i++) {
+        if (peak[i] > EPSILON) {
+            planar_velocity = min(planar_velocity, (float)cbrt(cm->a[axis[i]].jerk_max * JERK_MULTIPLIER * r2 / peak[i]));
+        }
+    }
+    if (cm->arc.gm.feed_rate_mode == INVERSE_TIME_MODE) {   // stretch the move time (minutes)
+        cm->arc.gm.feed_rate = max(cm->arc.gm.feed_rate, planar_travel / planar_velocity);
+    } else {                                                // the feed rate is along the helix
+        cm->arc.gm.feed_rate = min(cm->arc.gm.feed_rate, planar_velocity * cm->arc.length / planar_travel);
+    }
+}
+
 /*
  * _estimate_arc_time ()
  *
- *  Returns a naiive estimate of arc execution time to inform segment calculation.
+ *  Returns an estimate of arc execution time to inform segment calculation.
  *  The arc time is computed not to exceed the time taken in the slowest dimension
- *  in the arc plane or in linear travel. Maximum feed rates are compared in each
- *  dimension, but the comparison assumes that the arc will have at least one segment
- *  where the unit vector is 1 in that dimension. This is not true for any arbitrary arc,
- *  with the result that the time returned may be less than optimal.
+ *  in the arc plane or in linear travel. Each plane axis only carries its peak share
+ *  of the planar travel rate over the arc's angular span (see _max_abs_cos()), so a
+ *  short arc is not limited by an axis it barely moves.
  */
 static float _estimate_arc_time (float arc_time)
 {
@@ -493,12 +553,15 @@ static float _estimate_arc_time (float arc_time)
     if (cm->arc.gm.feed_rate_mode == INVERSE_TIME_MODE) {
         arc_time = cm->arc.gm.feed_rate;    // inverse feed rate has been normalized to minutes
     } else {
-        arc_time = cm->arc.length / cm->gm.feed_rate;
+        arc_time = cm->arc.length / cm->arc.gm.feed_rate;
     }
 
     // Downgrade the time if there is a rate-limiting axis
-    arc_time = max(arc_time, (float)fabs(cm->arc.planar_travel/cm->a[cm->arc.plane_axis_0].feedrate_max));
-    arc_time = max(arc_time, (float)fabs(cm->arc.planar_travel/cm->a[cm->arc.plane_axis_1].feedrate_max));
+    float planar_travel = fabs(cm->arc.planar_travel);
+    arc_time = max(arc_time, planar_travel * _max_abs_cos(cm->arc.theta, cm->arc.angular_travel) /
+                             cm->a[cm->arc.plane_axis_0].feedrate_max);
+    arc_time = max(arc_time, planar_travel * _max_abs_cos(cm->arc.theta - M_PI/2, cm->arc.angular_travel) /
+                             cm->a[cm->arc.plane_axis_1].feedrate_max);
     if (fabs(cm->arc.linear_travel) > 0) {
         arc_time = max(arc_time, (float)fabs(cm->arc.linear_travel/cm->a[cm->arc.linear_axis].feedrate_max));
     }
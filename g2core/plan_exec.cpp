@@ -45,6 +45,26 @@ static stat_t _exec_aline_tail(mpBuf_t *bf);
 static stat_t _exec_aline_segment(void);
 static void   _exec_aline_normalize_block(mpBlockRuntimeBuf_t *b);
 static stat_t _exec_aline_feedhold(mpBuf_t *bf);
+static float  _spindle_sync_segment_time(void);
+
+// G33 spindle synchronization for the running block - see _spindle_sync_segment_time()
+static struct mpSpindleSync {
+    bool active;                    // the running block is spindle synchronized
+    float rpm;                      // spindle speed the block was planned for
+    float plan_time;                // planned time of the segments prepped so far (minutes)
+    float last_time;                // synchronized time of the last segment prepped (minutes)
+    volatile bool alarm_requested;  // the spindle left the range the axes can follow
+    float alarm_rpm;                // measured speed that raised the alarm
+    uint32_t alarm_linenum;         // line number of the block
+} ss;
+
+// G93 blocks that could not be planned to their programmed time - see _check_inverse_time()
+static struct mpInverseTimeReport {
+    volatile uint32_t misses;       // blocks missed since the last report (written by forward planning)
+    volatile uint32_t linenum;      // line number of the last block missed
+    volatile float overrun;         // how far the last block missed by (minutes)
+    volatile bool jerk_limited;     // last block was held back by jerk, otherwise by axis feedrate max
+} itr;
 
 static void _init_forward_diffs(float v_0, float v_1);
 
@@ -168,10 +188,15 @@ static void _init_forward_diffs(float v_0, float v_1);
  * mr->p is only advanced in mp_exec_aline(), after mp.r = mr->p.
  * This code aligns the buffers and the blocks for exec_aline().
  */
+static void _check_inverse_time(const mpBlockRuntimeBuf_t *block, const mpBuf_t *bf);
+
 static stat_t _plan_aline(mpBuf_t *bf, float entry_velocity)
 {
     mpBlockRuntimeBuf_t* block = mr->p;             // set a local planning block so pointer doesn't change on you
     mp_calculate_ramps(block, bf, entry_velocity);  // (which it will if you don't do this)
+    if (bf->inverse_time > 0) {
+        _check_inverse_time(block, bf);
+    }
 
     debug_trap_if_true((block->exit_velocity > block->cruise_velocity), 
         "_plan_line() exit velocity > cruise velocity after calculate_ramps()");
@@ -184,6 +209,63 @@ static stat_t _plan_aline(mpBuf_t *bf, float entry_velocity)
     return (STAT_OK);                               // report that we planned something...
 }
 
+/*
+ * _check_inverse_time() - count G93 blocks planned over their programmed time
+ *
+ *  Back planning raises the cruise of G93 blocks to meet their programmed time - see
+ *  _plan_inverse_time() in plan_line.cpp. Its estimate assumes the fastest entry the block
+ *  can have, so a block that enters slower, or is too short to reach its cruise, can still
+ *  run long. Blocks over by more than INVERSE_TIME_TOLERANCE are counted here and reported
+ *  from the main loop by mp_inverse_time_callback(). Nothing is replanned at this level.
+ */
+static void _check_inverse_time(const mpBlockRuntimeBuf_t *block, const mpBuf_t *bf)
+{
+    float target_time = bf->inverse_time / (fp_ZERO(bf->override_factor) ? 1.0 : bf->override_factor);
+    if (bf->block_time > target_time * (1 + INVERSE_TIME_TOLERANCE)) {
+        itr.linenum = bf->gm.linenum;
+        itr.overrun = bf->block_time - target_time;
+        itr.jerk_limited = VELOCITY_LT(block->cruise_velocity, bf->cruise_vmax);
+        itr.misses++;
+    }
+}
+
+/*
+ * mp_spindle_sync_callback() - alarm when a G33 block lost its spindle sync
+ */
+
+stat_t mp_spindle_sync_callback()
+{
+    if (!ss.alarm_requested) {
+        return (STAT_NOOP);
+    }
+    ss.alarm_requested = false;
+    char msg[64];
+    sprintf(msg, "line %lu, planned %0.0f rpm, measured %0.0f rpm",
+            (unsigned long)ss.alarm_linenum, ss.rpm, ss.alarm_rpm);
+    cm_alarm(STAT_SPINDLE_SYNC_LOST, msg);
+    return (STAT_OK);
+}
+
+/*
+ * mp_inverse_time_callback() - report G93 blocks that ran long
+ *
+ *  Misses are coalesced - one exception per main loop pass covers every block counted
+ *  since the last one, and names the last of them.
+ */
+stat_t mp_inverse_time_callback()
+{
+    if (itr.misses == 0) {
+        return (STAT_NOOP);
+    }
+    char msg[80];
+    uint32_t misses = itr.misses;
+    sprintf(msg, "%lu block(s), last line %lu %0.1fms over, %s limited", (unsigned long)misses,
+            (unsigned long)itr.linenum, itr.overrun * 60000, itr.jerk_limited ? "jerk" : "feedrate");
+    itr.misses -= misses;                           // keep any counted while formatting
+    rpt_exception(STAT_INVERSE_TIME_NOT_MET, msg);
+    return (STAT_OK);
+}
+
 stat_t mp_forward_plan()
 {
     mpBuf_t *bf = mp_get_run_buffer();
@@ -292,6 +374,9 @@ stat_t mp_exec_move()
 
             if (bf->buffer_state == MP_BUFFER_FULLY_PLANNED) {
                 bf->buffer_state = MP_BUFFER_RUNNING;       // must precede mp_planner_time_acccounting()
+                if (bf->block_type == BLOCK_TYPE_ALINE) {
+                    mp->run_time_remaining = bf->block_time;// counted down by _exec_aline_segment()
+                }
             } else {
                 return (STAT_NOOP);
             }
@@ -439,6 +524,11 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         // Start a new move by setting up the runtime singleton (mr)
         memcpy(&mr->gm, &(bf->gm), sizeof(GCodeState_t));   // copy in the gcode model state
         bf->block_state = BLOCK_ACTIVE;                     // note that this buffer is running
+
+        ss.active = (mr->gm.spindle_sync_pitch > 0);       // G33
+        ss.rpm = ss.active ? (mr->gm.feed_rate / mr->gm.spindle_sync_pitch) : 0;
+        ss.plan_time = 0;
+        ss.last_time = 0;
         mr->block_state = BLOCK_INITIAL_ACTION;             // note the planner doesn't look at block_state
 
         // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -455,6 +545,7 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         copy_vector(mr->unit, bf->unit);
         copy_vector(mr->target, bf->gm.target);
         copy_vector(mr->axis_flags, bf->axis_flags);
+        kn_load_projection();                           // axis-to-motor mapping is fixed for the block
 
         mr->run_bf = bf;                                // DIAGNOSTIC: points to running bf
         mr->plan_bf = bf->nx;                           // DIAGNOSTIC: points to next bf to forward plan
@@ -524,6 +615,7 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         if ((status == STAT_OK) || (status == STAT_NOOP)) {
             cm->hold_state = FEEDHOLD_DECEL_COMPLETE;
             bf->block_state = BLOCK_INITIAL_ACTION;     // reset bf so it can restart the rest of the move
+            bf->gm.spindle_sync_pitch = 0;              // a G33 thread is lost - finish it unsynchronized
         }
     }
     
@@ -944,13 +1036,15 @@ static stat_t _exec_aline_segment()
     }
 
     // Update the mb->run_time_remaining -- we know it's missing the current segment's time before it's loaded, that's ok.
-    mp->run_time_remaining -= mr->segment_time;
-    if (mp->run_time_remaining < 0) {
-        mp->run_time_remaining = 0.0;
-    }
-
-    // Call the stepper prep function
-    ritorno(st_prep_line(travel_steps, mr->following_error, mr->segment_time));
+    // Single store so readers never see a negative value
+    float run_time_remaining = mp->run_time_remaining - mr->segment_time;
+    mp->run_time_remaining = (run_time_remaining < 0) ? 0.0 : run_time_remaining;
+    jp_add_executed_time(mr->segment_time);                 // job progress accounting
+
+    // Call the stepper prep function. Spindle synchronized segments run in spindle time.
+    float segment_time = ss.active ? _spindle_sync_segment_time() : mr->segment_time;
+    ritorno(st_prep_line(travel_steps, mr->following_error, segment_time,
+                         (mr->section == SECTION_BODY) ? MOTION_PHASE_CRUISE : MOTION_PHASE_RAMP));
     copy_vector(mr->position, mr->gm.target);               // update position from target
     if (mr->segment_count == 0) {
         return (STAT_OK);                                   // this section has run all its segments
@@ -958,6 +1052,57 @@ static stat_t _exec_aline_segment()
     return (STAT_EAGAIN);                                   // this section still has more segments to run
 }
 
+/*********************************************************************************************
+ * _spindle_sync_segment_time() - time a G33 segment against the measured spindle
+ *
+ *  A spindle synchronized block is planned at the programmed S. Each segment's planned
+ *  time is scaled by planned / measured RPM, so the segment takes as long as the measured
+ *  spindle needs to turn through the revolutions the plan assigns to it. What's left -
+ *  start latency and the 1 ms resolution of the index timing - is closed as a phase error
+ *  between planned and measured revolutions. The error is taken at the start of the
+ *  segment, which begins when the segment now running ends.
+ *
+ *  This keeps the plan's time base in step with the spindle. It does not change the plan,
+ *  so in the head and tail the axes travel less than the pitch per revolution and only the
+ *  body cuts the programmed pitch - see cm_spindle_sync_feed() for lead-in and lead-out.
+ *
+ *  The first segment is prepped while the index wait is still running, before the phase
+ *  reference is taken, so it is only rate scaled. Corrections are clamped so the axes
+ *  can't be driven far past their planned velocity and jerk, and a hold drops the sync.
+ *  A spindle that is off by more than the rate clamps allow (including stopped) can no
+ *  longer be followed, so the sync is dropped and mp_spindle_sync_callback() alarms.
+ */
+
+static float _spindle_sync_segment_time()
+{
+    if (cm->hold_state != FEEDHOLD_OFF) {
+        ss.active = false;
+        return (mr->segment_time);
+    }
+    float rpm = en_spindle_rpm();
+    float stretch = SPINDLE_SYNC_MAX_STRETCH;
+    if (rpm > 0) {
+        stretch = std::max(std::min(ss.rpm / rpm, SPINDLE_SYNC_MAX_STRETCH), 1 / SPINDLE_SYNC_MAX_SPEEDUP);
+    }
+    if ((stretch >= SPINDLE_SYNC_MAX_STRETCH) || (stretch <= 1 / SPINDLE_SYNC_MAX_SPEEDUP)) {
+        ss.alarm_rpm = rpm;                         // the thread is lost - alarm from the main loop
+        ss.alarm_linenum = mr->gm.linenum;
+        ss.alarm_requested = true;
+        ss.active = false;
+        return (mr->segment_time * stretch);
+    }
+    if (en_spindle_is_referenced()) {
+        float spindle_revs = en_spindle_revolutions() + (ss.last_time * rpm);
+        float phase_error = (ss.plan_time * ss.rpm) - spindle_revs;    // positive if the axes are ahead
+        phase_error -= floor(phase_error + 0.5);                        // only the angle matters
+        float correction = (phase_error / ss.rpm) / (SPINDLE_SYNC_CORRECTION_MS / 60000);
+        stretch += std::max(-SPINDLE_SYNC_MAX_CORRECTION, std::min(correction, SPINDLE_SYNC_MAX_CORRECTION));
+    }
+    ss.plan_time += mr->segment_time;
+    ss.last_time = mr->segment_time * stretch;
+    return (ss.last_time);
+}
+
 /*********************************************************************************************
  * _exec_aline_normalize_block() - re-organize block to eliminate minimum time segments
  *
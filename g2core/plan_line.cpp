@@ -50,6 +50,7 @@ extern OutputPin<kDebug3_PinNumber> debug_pin3;
 // planner helper functions
 static mpBuf_t* _plan_block(mpBuf_t* bf);
 static void _calculate_override(mpBuf_t* bf);
+static void _plan_inverse_time(mpBuf_t* bf);
 static void _calculate_jerk(mpBuf_t* bf);
 static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const float axis_square[]);
 static void _calculate_junction_vmax(mpBuf_t* bf);
@@ -338,6 +339,11 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
             bf->cruise_velocity = max(braking_velocity, bf->cruise_velocity);
             bf->exit_velocity   = braking_velocity;
 
+            // G93 blocks raise their cruise to meet the programmed time, then get hinted with it
+            if ((bf->inverse_time > 0) && (cm->hold_state == FEEDHOLD_OFF)) {
+                _plan_inverse_time(bf);
+            }
+
             // We have two places where it could be a mixed decel or an asymmetric bump,
             // depending on if the pv->exit_vmax is the same as bf.cruise_vmax
             bool test_decel_or_bump = false;
@@ -444,6 +450,7 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
 
 /***** ALINE HELPERS *****
  * _calculate_override() - calculate cruise_vmax given cruise_vset and feed rate factor
+ * _plan_inverse_time()  - raise cruise_vmax so a G93 block runs in its programmed time
  * _calculate_jerk()
  * _calculate_vmaxes()
  * _calculate_junction_vmax()
@@ -454,8 +461,17 @@ static void _calculate_override(mpBuf_t* bf)  // execute ramp to adjust cruise v
 {
     // TODO: Account for rapid overrides as well as feed overrides
 
+    // G33 feed is set by the pitch and spindle speed - an override would cut the wrong thread
+    if (bf->gm.spindle_sync_pitch > 0) {
+        bf->override_factor = 1.0;
+        bf->cruise_vmax = bf->cruise_vset;
+        return;
+    }
+
     // pull in override factor from previous block or seed initial value from the system setting
-    bf->override_factor = fp_ZERO(bf->pv->override_factor) ? cm->gmx.mfo_factor : bf->pv->override_factor;
+    // (also after a G33 block, which doesn't carry the override)
+    bf->override_factor = (fp_ZERO(bf->pv->override_factor) || (bf->pv->gm.spindle_sync_pitch > 0)) ?
+                          cm->gmx.mfo_factor : bf->pv->override_factor;
     bf->cruise_vmax     = bf->override_factor * bf->cruise_vset;
 
     // generate ramp term is a ramp is active
@@ -497,6 +513,50 @@ static void _calculate_override(mpBuf_t* bf)  // execute ramp to adjust cruise v
     // }
 }
 
+/*
+ *  _plan_inverse_time() is called from back planning once the block's exit velocity is set.
+ *  cruise_vset is length / programmed time, which is only met if the block cruises from end
+ *  to end. Any head or tail makes the block run long, so a G93 program drifts behind the
+ *  timing the CAM assumed. The block time is estimated from the ramp lengths - taking the
+ *  entry as pv->exit_vmax - and the cruise is scaled by estimated / programmed time until
+ *  they agree. Only ramp lengths are computed, so no ramps are built here or in forward
+ *  planning. cruise_velocity is raised with cruise_vmax, as forward planning caps the
+ *  cruise there, and the hinting that follows sees the raised cruise.
+ *
+ *  Each pass starts again from the overridden cruise_vset, so replanning never compounds
+ *  it. The cruise can't go past bf->inverse_vmax (rate-limiting axis) and stops rising once
+ *  the head and tail no longer fit (jerk limited). Feed override scales the programmed time.
+ *  Blocks still over are reported by forward planning - see _check_inverse_time().
+ */
+
+static void _plan_inverse_time(mpBuf_t* bf)
+{
+    float target_time = bf->inverse_time / (fp_ZERO(bf->override_factor) ? 1.0 : bf->override_factor);
+    float cruise = bf->cruise_vset * (fp_ZERO(bf->override_factor) ? 1.0 : bf->override_factor);
+    float velocity = cruise;
+
+    for (uint8_t i=0; i < INVERSE_TIME_ITERATIONS; i++) {
+        float v_0 = min(bf->pv->exit_vmax, velocity);
+        float v_1 = min(bf->exit_velocity, velocity);
+        float head_length = mp_get_target_length(v_0, velocity, bf);
+        float tail_length = mp_get_target_length(v_1, velocity, bf);
+        float body_length = bf->length - head_length - tail_length;
+        if (body_length < 0) {
+            break;                                      // the ramps no longer fit - jerk limited
+        }
+        float block_time = (2 * head_length / (v_0 + velocity)) +
+                           (2 * tail_length / (v_1 + velocity)) + (body_length / velocity);
+        cruise = velocity;
+        if ((block_time <= target_time * (1 + INVERSE_TIME_TOLERANCE)) ||
+            !VELOCITY_LT(velocity, bf->inverse_vmax)) {
+            break;                                      // met, or at the axis limit
+        }
+        velocity = min(velocity * block_time / target_time, bf->inverse_vmax);
+    }
+    bf->cruise_vmax     = cruise;
+    bf->cruise_velocity = max(cruise, bf->exit_velocity);
+}
+
 /****************************************************************************************
  * _calculate_jerk() - calculate jerk given the dynamic state
  *
@@ -564,6 +624,11 @@ static void _calculate_jerk(mpBuf_t* bf)
  *  absolute_vmax is the time limited by the rate-limiting axis. It is saved for possible
  *  use later in feed override computation.
  *
+ *  For G93 the programmed time is also kept in bf->inverse_time. cruise_vset only gives that
+ *  time if the block has no ramps, so back planning raises the cruise velocity to absorb
+ *  the head and tail - see _plan_inverse_time(). bf->inverse_vmax caps this at the
+ *  rate-limiting axis.
+ *
  *  Velocities may be also be degraded (slowed down) if:
  *    - The block calls for a time that is less than the minimum update time (min segment time).
  *      This is very important to ensure proper block planning and trapezoid generation.
@@ -636,6 +701,7 @@ static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const floa
     if (bf->gm.motion_mode != MOTION_MODE_STRAIGHT_TRAVERSE) {
         if (bf->gm.feed_rate_mode == INVERSE_TIME_MODE) {
             feed_time = bf->gm.feed_rate;  // NB: feed rate was un-inverted to minutes by cm_set_feed_rate()
+            bf->inverse_time = feed_time;  // forward planning holds the block to this time
             bf->gm.feed_rate_mode = UNITS_PER_MINUTE_MODE;
         } else {
             // compute length of linear move in millimeters. Feed rate is provided as mm/min
@@ -668,6 +734,9 @@ static void _calculate_vmaxes(mpBuf_t* bf, const float axis_length[], const floa
     bf->cruise_vmax   = bf->cruise_vset;          // starting value for cruise vmax
     bf->absolute_vmax = bf->length / min_time;    // absolute velocity limit
     bf->block_time    = block_time;               // initial estimate - used for ramp computations
+    if (bf->inverse_time > 0) {                   // G93 time target and the ceiling for meeting it
+        bf->inverse_vmax = bf->length / max(max_time, MIN_BLOCK_TIME);
+    }
 }
 
 /****************************************************************************************
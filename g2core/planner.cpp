@@ -62,6 +62,8 @@
 #include "report.h"
 #include "util.h"
 #include "json_parser.h"
+#include "gpio.h"
+#include "controller.h"
 #include "xio.h"
 
 // Allocate planner structures
@@ -80,6 +82,7 @@ mpBuf_t mp2_queue[SECONDARY_QUEUE_SIZE];    // storage allocation for secondary
 // Execution routines (NB: These are called from the LO interrupt)
 static stat_t _exec_dwell(mpBuf_t *bf);
 static stat_t _exec_command(mpBuf_t *bf);
+static void _input_wait_reset(void);
 
 // DIAGNOSTICS
 //static void _planner_time_accounting();
@@ -142,6 +145,69 @@ struct _json_commands_t {
 };
 _json_commands_t jc;
 
+/*
+ * Pre-compiled JSON commands (M100)
+ *
+ *  M100 commands with only numeric and boolean values are resolved to cfgArray indexes
+ *  and typed values when they are queued, so the runtime only has to run the setters.
+ *  The records are much smaller than the raw strings so more of them can be queued.
+ *  Commands the compiler can't handle (strings, too many pairs, SR setup) fall back to
+ *  the raw string buffers above and are parsed in the runtime as before.
+ */
+
+#define JSON_COMPILED_BUFFER_SIZE 12    // pre-compiled M100 commands that can be queued
+#define JSON_COMPILED_ITEMS 4           // name/value pairs in a pre-compiled command
+
+struct json_compiled_item_t {
+    index_t index;                      // cfgArray index resolved at queue time
+    uint8_t valuetype;                  // TYPE_FLOAT, TYPE_INTEGER or TYPE_BOOLEAN
+    float value_flt;
+    int32_t value_int;
+};
+
+struct json_compiled_command_t {
+    uint8_t count;                      // items in use
+    json_compiled_item_t item[JSON_COMPILED_ITEMS];
+};
+
+struct _json_compiled_commands_t {
+    json_compiled_command_t _cmd[JSON_COMPILED_BUFFER_SIZE];
+    uint8_t _r;                         // next command to run (exec)
+    uint8_t _w;                         // next command to write (main loop)
+    std::atomic<uint8_t> available;     // written by both the main loop and the exec
+
+    _json_compiled_commands_t() {
+        reset();
+    };
+
+    // Get the next free record to compile into. It's not used up until commit_buffer()
+    json_compiled_command_t *get_write_buffer() {
+        return &_cmd[_w];
+    };
+
+    void commit_buffer() {
+        _w = (_w + 1 == JSON_COMPILED_BUFFER_SIZE) ? 0 : _w + 1;
+        available--;
+    };
+
+    // Read a record out, but do NOT free it (so it can be used directly)
+    json_compiled_command_t *read_buffer() {
+        return &_cmd[_r];
+    };
+
+    void free_buffer() {
+        _r = (_r + 1 == JSON_COMPILED_BUFFER_SIZE) ? 0 : _r + 1;
+        available++;
+    };
+
+    void reset() {
+        _r = 0;
+        _w = 0;
+        available = JSON_COMPILED_BUFFER_SIZE;
+    };
+};
+_json_compiled_commands_t jcc;
+
 /****************************************************************************************
  * planner_init() - initialize MP, MR and planner queue buffers
  * planner_reset() - selective reset MP and MR structures
@@ -155,7 +221,7 @@ void _init_planner_queue(mpPlanner_t *_mp, mpBuf_t *queue, uint8_t size)
     uint8_t i, nx_i;
     mpPlannerQueue_t *q = &(_mp->q);
 
-    memset(q, 0, sizeof(mpPlannerQueue_t)); // clear values, pointers and status
+    // every field is set below - the queue holds atomics, so it isn't memset
     q->magic_start = MAGICNUM;
     q->magic_end = MAGICNUM;
 
@@ -165,6 +231,7 @@ void _init_planner_queue(mpPlanner_t *_mp, mpBuf_t *queue, uint8_t size)
     q->r = queue;
     q->queue_size = size;
     q->buffers_available = size;
+    q->buffers_in_run = 0;
     
     pv = &q->bf[size-1];
     for (i=0; i < size; i++) {
@@ -180,11 +247,19 @@ void _init_planner_queue(mpPlanner_t *_mp, mpBuf_t *queue, uint8_t size)
 
 void planner_init(mpPlanner_t *_mp, mpPlannerRuntime_t *_mr, mpBuf_t *queue, uint8_t queue_size)
 {
-    // init planner master structure
-    memset(_mp, 0, sizeof(mpPlanner_t));    // clear all values, pointers and status    
+    // init planner master structure. It holds atomics, so it is cleared by field rather than memset
     _mp->magic_start = MAGICNUM;            // set boundary condition assertions
     _mp->magic_end = MAGICNUM;
+    _mp->run_time_remaining_ms = 0;
+    _mp->plannable_time_ms = 0;
+    clear_vector(_mp->position);
+    _mp->reset();                           // timing and state variables
     _mp->mfo_factor = 1.00;
+    _mp->ramp_target = 0;
+    _mp->ramp_dvdt = 0;
+    _mp->p = nullptr;
+    _mp->c = nullptr;
+    _mp->planning_return = nullptr;
    
     // init planner queues
     _mp->q.bf = queue;                      // assign puffer pool to queue manager structure
@@ -208,6 +283,8 @@ void planner_reset(mpPlanner_t *_mp)        // reset planner queue, cease MR act
     _mp->reset();
     _mp->mr->reset();
     jc.reset();
+    jcc.reset();
+    _input_wait_reset();
     _init_planner_queue(_mp, _mp->q.bf, _mp->q.queue_size); // reset planner buffers
 }
 
@@ -265,6 +342,7 @@ void mp_set_runtime_position(uint8_t axis, const float position) { mr->position[
 void mp_set_steps_to_runtime_position()
 {
     float step_position[MOTORS];
+    kn_load_projection();                                   // pick up any changes to motor mapping
     kn_inverse_kinematics(mr->position, step_position);     // convert lengths to steps in floating point
     for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
         mr->target_steps[motor] = step_position[motor];
@@ -336,11 +414,63 @@ stat_t mp_runtime_command(mpBuf_t *bf)
 }
 
 /****************************************************************************************
- * _exec_json_command() - execute json string (from exec system)
- * mp_json_command()    - queue a json command
+ * _compile_json_command()     - compile a parsed json command into a record
+ * _exec_json_compiled()       - run a pre-compiled json command (from exec system)
+ * _exec_json_command()        - execute json string (from exec system)
+ * mp_json_command()           - queue a json command
  * mp_json_command_immediate() - execute a json command with response suppressed
  */
 
+static bool _compile_json_command(json_compiled_command_t *cmd)
+{
+    cmd->count = 0;
+    for (nvObj_t *nv = nv_queue; (nv != NULL) && (nv->valuetype != TYPE_EMPTY); nv = nv->nx) {
+        if (nv->valuetype == TYPE_PARENT) {
+            if (strcmp(nv->token, "sr") == 0) {     // SR setup needs the parser - see _json_parser_execute()
+                return (false);
+            }
+            continue;
+        }
+        if (nv->valuetype == TYPE_NULL) {           // GETs have nobody to respond to in the runtime
+            continue;
+        }
+        if (((nv->valuetype != TYPE_FLOAT) && (nv->valuetype != TYPE_INTEGER) && (nv->valuetype != TYPE_BOOLEAN)) ||
+            (cmd->count == JSON_COMPILED_ITEMS)) {
+            return (false);
+        }
+        json_compiled_item_t *item = &cmd->item[cmd->count++];
+        item->index = nv->index;
+        item->valuetype = nv->valuetype;
+        item->value_flt = nv->value_flt;
+        item->value_int = nv->value_int;
+    }
+    return (true);
+}
+
+static void _exec_json_compiled(float *value, bool *flag)
+{
+    json_compiled_command_t *cmd = jcc.read_buffer();
+    nvObj_t nv;
+
+    nv.pv = NULL;
+    nv.nx = NULL;
+    for (uint8_t i=0; i < cmd->count; i++) {
+        if (cm_is_alarmed() != STAT_OK) {           // same as the parser - stop setting once alarmed
+            break;
+        }
+        nv.index = cmd->item[i].index;
+        nv_load_nvObj(&nv);                         // group and token, as some setters use them
+        nv.valuetype = (valueType)cmd->item[i].valuetype;
+        nv.value_flt = cmd->item[i].value_flt;
+        nv.value_int = cmd->item[i].value_int;
+        if (nv_set(&nv) != STAT_OK) {
+            break;
+        }
+        nv_persist(&nv);
+    }
+    jcc.free_buffer();
+}
+
 static void _exec_json_command(float *value, bool *flag)
 {
     char *json_string = jc.read_buffer();
@@ -350,8 +480,14 @@ static void _exec_json_command(float *value, bool *flag)
 
 stat_t mp_json_command(char *json_string)
 {
-    // Never supposed to fail, since we stopped parsing when we were full
-    jc.write_buffer(json_string);
+    // Never supposed to fail for lack of space, since we stopped parsing when we were full
+    ritorno(json_parse_for_queue(json_string));     // unknown names are reported against the Gcode line
+    if (_compile_json_command(jcc.get_write_buffer())) {
+        jcc.commit_buffer();
+        mp_queue_command(_exec_json_compiled, nullptr, nullptr);
+        return (STAT_OK);
+    }
+    jc.write_buffer(json_string);                   // the string was normalized by the parse; that's OK
     mp_queue_command(_exec_json_command, nullptr, nullptr);
     return (STAT_OK);
 }
@@ -361,6 +497,100 @@ stat_t mp_json_command_immediate(char *json_string)
     return json_parser(json_string);
 }
 
+/****************************************************************************************
+ * Input waits - shared by the JSON wait (M101) and the input wait (M66)
+ *
+ *  A wait holds the planner queue by prepping a polling dwell each time its condition
+ *  is checked and found unmet. The poll is only a backstop: gpio calls mp_input_changed()
+ *  from the pin change interrupt, which ends the polling dwell via st_end_dwell() so the
+ *  condition is re-checked within a SysTick of the edge rather than at the end of the poll.
+ *
+ *  The first poll may be prepped while the previous block (possibly a G4) is still
+ *  running, so it's kept to a single tick and only later polls are ended in the runtime.
+ */
+
+static struct mpInputWait {
+    volatile bool active;           // a wait is being run by the exec
+    uint8_t input;                  // M66 input number (1-based), or 0 to re-check on any input (M101)
+    inputWaitMode mode;             // M66 wait mode
+    uint32_t start;                 // SysTick time the wait started
+    uint32_t timeout_ms;            // M66 timeout, 0 for none
+    volatile uint16_t polls;        // polling dwells prepped by this wait
+    volatile bool triggered;        // the input has changed the way the wait is looking for
+
+    volatile bool report_requested; // an M66 result is waiting to be reported
+    uint8_t report_input;           // input the result is for
+    int8_t report_value;            // 1 or 0 for the input state, -1 for timeout
+    volatile bool index_alarm_requested;    // a G33 index wait timed out
+} iw;
+
+static void _input_wait_start(uint8_t input, inputWaitMode mode, uint32_t timeout_ms)
+{
+    iw.input = input;
+    iw.mode = mode;
+    iw.start = SysTickTimer_getValue();
+    iw.timeout_ms = timeout_ms;
+    iw.polls = 0;
+    iw.triggered = false;
+    iw.active = true;
+}
+
+static void _input_wait_poll(float milliseconds)
+{
+    if (iw.polls++ == 0) {
+        milliseconds = 0;                           // st_prep_dwell() rounds up to one tick
+    }
+    st_prep_dwell(milliseconds * 1000);             // convert to uSec
+    if (iw.triggered) {                             // an edge arrived after the check
+        st_end_dwell(iw.polls > 1);
+    }
+}
+
+static void _input_wait_finish(void)
+{
+    iw.active = false;
+    if (mp_free_run_buffer()) {
+        cm_cycle_end();                             // free buffer & perform cycle_end if planner is empty
+    }
+}
+
+/*
+ * _input_wait_reset() - called from planner_reset() when the queue is flushed
+ *
+ *  A flush frees the wait's buffer without running _input_wait_finish(). If the wait was
+ *  left active the next input edge would call st_end_dwell() and cut short whatever dwell
+ *  is running then, e.g. a later G4.
+ */
+static void _input_wait_reset(void)
+{
+    iw.active = false;
+    iw.triggered = false;
+    iw.polls = 0;
+    iw.index_alarm_requested = false;
+}
+
+/*
+ * mp_input_changed() - called by gpio from the pin change interrupt
+ */
+
+void mp_input_changed(const uint8_t input, const bool active)
+{
+    if (!iw.active) {
+        return;
+    }
+    if (iw.input != 0) {                            // M66 only wakes for its own input and edge
+        if ((input != iw.input) || (iw.mode == INPUT_WAIT_IMMEDIATE)) {
+            return;
+        }
+        if (((iw.mode == INPUT_WAIT_RISE) || (iw.mode == INPUT_WAIT_HIGH) ||
+             (iw.mode == INPUT_WAIT_SPINDLE_INDEX)) != active) {
+            return;
+        }
+    }
+    iw.triggered = true;
+    st_end_dwell(iw.polls > 1);
+}
+
 /****************************************************************************************
  * _exec_json_wait() - execute json wait string
  * mp_json_wait()    - queue a json wait command
@@ -368,6 +598,12 @@ stat_t mp_json_command_immediate(char *json_string)
 
 static stat_t _exec_json_wait(mpBuf_t *bf)
 {
+    if (bf->block_state == BLOCK_INITIAL_ACTION) {
+        _input_wait_start(0, INPUT_WAIT_IMMEDIATE, 0);  // re-check whenever any input changes
+        bf->block_state = BLOCK_ACTIVE;
+    }
+    iw.triggered = false;                           // an input change from here on re-checks again
+
     char *json_string = jc.read_buffer();
 
     // process it
@@ -382,17 +618,14 @@ static stat_t _exec_json_wait(mpBuf_t *bf)
             nv_get_nvObj(nv);
             bool new_value = (bool)nv->value_int;
             if (old_value != new_value) {
-                st_prep_dwell((uint32_t)(0.1 * 1000000.0));// 1ms converted to uSec
+                _input_wait_poll(INPUT_WAIT_POLL_MS);
                 return STAT_OK;
             }
         }
         nv = nv->nx;
     }
     jc.free_buffer();
-
-    if (mp_free_run_buffer()) {
-        cm_cycle_end();                                    // free buffer & perform cycle_end if planner is empty
-    }
+    _input_wait_finish();
     return (STAT_OK);
 }
 
@@ -414,6 +647,109 @@ stat_t mp_json_wait(char *json_string)
     return (STAT_OK);
 }
 
+/****************************************************************************************
+ * _exec_input_wait()       - run an input wait
+ * mp_input_wait()          - queue an input wait (M66)
+ * mp_input_wait_callback() - report the result of the last input wait
+ *
+ *  The result is 1 or 0 for the state of the input when the wait was satisfied, or -1
+ *  if the wait timed out. Edge modes count edges from the time the wait starts running
+ *  in the exec, which may be up to one block ahead of the motors.
+ *
+ *  The G33 spindle index wait is not reported. It only starts looking once the previous
+ *  block has finished in the steppers, arms the spindle phase reference so it is taken
+ *  on the same pulse that releases the wait, and raises an alarm instead of continuing
+ *  if no index pulse arrives in time.
+ */
+
+static stat_t _exec_input_wait(mpBuf_t *bf)
+{
+    if (bf->block_state == BLOCK_INITIAL_ACTION) {
+        _input_wait_start((uint8_t)bf->unit[0], (inputWaitMode)bf->unit[1], (uint32_t)(bf->unit[2] * 1000));
+        bf->block_state = BLOCK_ACTIVE;
+        if (iw.mode == INPUT_WAIT_SPINDLE_INDEX) {  // run the single tick poll behind the previous block
+            _input_wait_poll(0);
+            return (STAT_OK);
+        }
+    }
+    if ((iw.mode == INPUT_WAIT_SPINDLE_INDEX) && (iw.polls == 1)) {
+        iw.triggered = false;                       // ignore pulses from before the motors stopped
+        iw.start = SysTickTimer_getValue();
+        en_spindle_arm();
+    }
+
+    bool state = gpio_read_input(iw.input);
+    bool done = false;
+    switch (iw.mode) {
+        case INPUT_WAIT_IMMEDIATE: { done = true; break; }
+        case INPUT_WAIT_RISE:      { done = iw.triggered; state = true; break; }
+        case INPUT_WAIT_FALL:      { done = iw.triggered; state = false; break; }
+        case INPUT_WAIT_HIGH:      { done = state; break; }
+        case INPUT_WAIT_LOW:       { done = !state; break; }
+        case INPUT_WAIT_SPINDLE_INDEX: { done = iw.triggered; break; }
+    }
+    int32_t remaining_ms = (int32_t)INPUT_WAIT_POLL_MS;
+    if (iw.timeout_ms > 0) {
+        remaining_ms = (int32_t)(iw.timeout_ms - (SysTickTimer_getValue() - iw.start));
+    }
+
+    if ((iw.mode == INPUT_WAIT_SPINDLE_INDEX) && !done && (remaining_ms <= 0)) {
+        iw.index_alarm_requested = true;            // hold the queue until the alarm flushes it
+        remaining_ms = (int32_t)INPUT_WAIT_POLL_MS;
+    }
+    if (done || (remaining_ms <= 0)) {
+        if (iw.mode != INPUT_WAIT_SPINDLE_INDEX) {
+            iw.report_input = iw.input;
+            iw.report_value = done ? (int8_t)state : -1;
+            iw.report_requested = true;
+        }
+        _input_wait_finish();
+        return (STAT_OK);
+    }
+    _input_wait_poll(std::min((float)remaining_ms, INPUT_WAIT_POLL_MS));
+    return (STAT_OK);
+}
+
+stat_t mp_input_wait(const uint8_t input, const inputWaitMode mode, const float timeout)
+{
+    mpBuf_t *bf;
+
+    // Never supposed to fail as buffer availability was checked upstream in the controller
+    if ((bf = mp_get_write_buffer()) == NULL) {
+        cm_panic(STAT_FAILED_GET_PLANNER_BUFFER, "mp_input_wait()");
+        return STAT_ERROR;
+    }
+    bf->block_type = BLOCK_TYPE_COMMAND;
+    bf->bf_func = _exec_input_wait;     // callback to planner queue exec function
+    bf->unit[0] = input;                // use the unit vector to store command values
+    bf->unit[1] = mode;
+    bf->unit[2] = timeout;              // seconds, 0 waits forever
+    mp_commit_write_buffer(BLOCK_TYPE_COMMAND);            // must be final operation before exit
+    return (STAT_OK);
+}
+
+static const char fmt_m66_json[] = "{\"m66\":{\"in\":%d,\"val\":%d}}\n";
+static const char fmt_m66_text[] = "[m66] input %d value:%7d\n";
+
+stat_t mp_input_wait_callback()
+{
+    if (iw.index_alarm_requested) {
+        iw.index_alarm_requested = false;
+        cm_alarm(STAT_SPINDLE_INDEX_NOT_FOUND, "G33 spindle index");
+        return (STAT_OK);
+    }
+    if (!iw.report_requested) {
+        return (STAT_NOOP);
+    }
+    if (xio_tx_backed_up()) {                       // report it once the host catches up
+        return (STAT_NOOP);
+    }
+    iw.report_requested = false;
+    sprintf(cs.out_buf, (js.json_mode == TEXT_MODE) ? fmt_m66_text : fmt_m66_json, (int)iw.report_input, (int)iw.report_value);
+    xio_writeline(cs.out_buf);
+    return (STAT_OK);
+}
+
 
 /****************************************************************************************
  * mp_dwell()    - queue a dwell
@@ -441,6 +777,7 @@ stat_t mp_dwell(float seconds)
 static stat_t _exec_dwell(mpBuf_t *bf)
 {
     st_prep_dwell((uint32_t)(bf->block_time * 1000000.0));// convert seconds to uSec
+    jp_add_executed_time(bf->block_time / 60);      // job progress accounting is in minutes
     if (mp_free_run_buffer()) {
         cm_cycle_end();                             // free buffer & perform cycle_end if planner is empty
     }
@@ -469,6 +806,7 @@ void mp_request_out_of_band_dwell(float seconds)
  * Planner helpers
  *
  * mp_get_planner_buffers()  - return # of available planner buffers
+ * mp_get_buffers_in_run()   - return # of committed buffers waiting to run or running
  * mp_planner_is_full()      - true if planner has no room for a new block
  * mp_has_runnable_buffer()  - true if next buffer is runnable, indicating motion has not stopped.
  * mp_is_it_phat_city_time() - test if there is time for non-essential processes
@@ -479,10 +817,15 @@ uint8_t mp_get_planner_buffers(const mpPlanner_t *_mp)  // which planner are you
     return (_mp->q.buffers_available);
 }
 
+uint8_t mp_get_buffers_in_run(const mpPlanner_t *_mp)
+{
+    return (_mp->q.buffers_in_run);
+}
+
 bool mp_planner_is_full(const mpPlanner_t *_mp)         // which planner are you interested in?
 {
     // We also need to ensure we have room for another JSON command
-    return ((_mp->q.buffers_available < PLANNER_BUFFER_HEADROOM) || (jc.available == 0));
+    return ((_mp->q.buffers_available < PLANNER_BUFFER_HEADROOM) || (jc.available == 0) || (jcc.available == 0));
 }
 
 bool mp_has_runnable_buffer(const mpPlanner_t *_mp)     // which planner are you interested in?)
@@ -525,6 +868,12 @@ bool mp_is_phat_city_time()
  *    motion starts. This eliminates an initial move that plans to zero and ensures
  *    the planner gets a "head start" on managing the time in the planner queue.
  *
+ *  - ...unless the input is idle, as for an MDI command or a pendant move. Then there
+ *    is nothing to fill up with and waiting out the block timeout only adds latency,
+ *    so STARTUP plans (to zero) immediately. Input is idle if no more lines are waiting
+ *    in RX, no arc is being generated, and the last line did not follow the one before
+ *    it within the block timeout. Streamed input keeps the fill-first behavior.
+ *
  *  - It's important to distinguish between the case where the new block is actually
  *    a startup condition and where it's the first block after a stop or a stall.
  *    The planner wants to perform a STARTUP in the first case, but start planning
@@ -533,6 +882,26 @@ bool mp_is_phat_city_time()
  *  - Feedholds require replanning to occur
  */
 
+static struct mpInputArrival {         // line arrival tracking for the planner startup policy
+    uint32_t line_tick;                 // SysTick time the last line was read
+    uint32_t line_interval;             // ms between the last two lines
+} ia;
+
+void mp_input_line_received()
+{
+    uint32_t now = SysTickTimer_getValue();
+    ia.line_interval = now - ia.line_tick;
+    ia.line_tick = now;
+}
+
+static bool _input_is_idle()
+{
+    if ((xio_get_rx_lines_queued() > 0) || (cm->arc.run_state != BLOCK_INACTIVE)) {
+        return (false);                             // more blocks are on the way
+    }
+    return (ia.line_interval > BLOCK_TIMEOUT_MS);
+}
+
 stat_t mp_planner_callback()
 {
     // Test if the planner has transitioned to an IDLE state
@@ -557,7 +926,7 @@ stat_t mp_planner_callback()
         mp->planner_state = PLANNER_STARTUP;
     }
     if (mp->planner_state == PLANNER_STARTUP) {
-        if (!mp_planner_is_full(mp) && !_timed_out) {
+        if (!mp_planner_is_full(mp) && !_timed_out && !_input_is_idle()) {
             return (STAT_OK);                       // remain in STARTUP
         }
         mp->planner_state = PLANNER_PRIMING;
@@ -664,6 +1033,37 @@ void mp_planner_time_accounting()
     UPDATE_MP_DIAGNOSTICS                           // DIAGNOSTIC
 }
 
+/*
+ * mp_get_planner_time() - return time needed to run everything in the planner queue (in minutes)
+ *
+ *  Unlike mp_planner_time_accounting() this includes the remainder of the running block
+ *  and blocks that are still plannable. Times of blocks that have not been planned yet are
+ *  estimates, so the result firms up as blocks move through the planner.
+ */
+
+float mp_get_planner_time(const mpPlanner_t *_mp)
+{
+    mpBuf_t *r = _mp->q.r;
+    mpBuf_t *bf = r;
+    float planner_time = 0;
+
+    if (r->buffer_state == MP_BUFFER_RUNNING) {     // running block is accounted by run_time_remaining
+        planner_time = _mp->run_time_remaining;
+        bf = bf->nx;
+    }
+    do {
+        if (bf->buffer_state == MP_BUFFER_EMPTY) {
+            break;
+        }
+        if (bf->block_type == BLOCK_TYPE_ALINE) {
+            planner_time += bf->block_time;
+        } else if (bf->block_type == BLOCK_TYPE_DWELL) {
+            planner_time += bf->block_time / 60;    // dwell times are kept in seconds
+        }
+    } while ((bf = bf->nx) != r);
+    return (planner_time);
+}
+
 /**** PLANNER BUFFER PRIMITIVES ************************************************************
  *
  *  Planner buffers are used to queue and operate on Gcode blocks. Each buffer contains
@@ -792,6 +1192,7 @@ void mp_commit_write_buffer(const blockType block_type)
 
     q->w->block_type = block_type;
     q->w->block_state = BLOCK_INITIAL_ACTION;
+    q->buffers_in_run++;                    // before the exec request below can free it
 
     if (block_type != BLOCK_TYPE_ALINE) {
         if ((mp->planner_state > PLANNER_STARTUP) && (cm->hold_state == FEEDHOLD_OFF)) {
@@ -834,6 +1235,7 @@ bool mp_free_run_buffer()           // EMPTY current run buffer & advance to the
     _clear_buffer(r_now);           // ... then clear out the old buffer (& set MP_BUFFER_EMPTY)
 //    r_now->buffer_state = MP_BUFFER_EMPTY; //... then mark the buffer empty while preserving content for debug inspection
     q->buffers_available++;
+    q->buffers_in_run--;
     qr_request_queue_report(-1);    // request a QR and add to the "removed buffers" count
     return (q->w == q->r);          // return true if the queue emptied
 }
@@ -846,6 +1248,228 @@ void mp_copy_buffer(mpBuf_t *bf, const mpBuf_t *bp)
 }
 */
 
+/************************************************************************************
+ * Planner queue snapshot
+ *
+ *  {"qs":t} captures every live block in the planner queue, running block first, and
+ *  streams one line per block as:
+ *
+ *    {"qs":[i,line,state,type,lim,len,tblk,vemax,vcmax,vxmax,ve,vc,vx,lh,lb,lt]}
+ *
+ *  i is the position in the queue (0 is the running block), line the gcode line number,
+ *  state and type the bufferState and blockType values, len the block length (mm), tblk
+ *  the block time (ms), ve/vc/vx the planned entry, cruise and exit velocities and the
+ *  *max values the limits they were planned against (mm/min). lh/lb/lt are the head, body
+ *  and tail lengths - taken from the runtime for the running block, and computed from the
+ *  planned velocities for the others as they have not been through the zoid yet. lim says
+ *  which limit set the cruise velocity:
+ *
+ *    0 = none (command block or not yet back planned), 1 = feedrate or velocity max,
+ *    2 = feed or traverse override, 3 = junction, 4 = jerk (block too short to reach vmax)
+ *
+ *  The readout ends with {"qs":n}, the number of blocks captured. Reading {"qs":n} returns
+ *  the number of live blocks. Text mode prints the same fields behind a [qs] tag.
+ *
+ *  The exec interrupt keeps running while the queue is copied. The copy is taken twice and
+ *  compared - if the runtime advanced or replanned a block in between the capture is
+ *  retried on the next main loop pass, so the snapshot is consistent without masking
+ *  interrupts. Streaming works like the probe history readout {prh}: it writes
+ *  PLANNER_SNAPSHOT_LINES_PER_PASS blocks per pass and holds off new commands until done.
+ *
+ * mp_get_qs()                  - get the number of live blocks in the queue
+ * mp_set_qs()                  - request a snapshot and readout
+ * mp_queue_snapshot_callback() - main loop callback that captures and streams the snapshot
+ */
+
+typedef struct mpSnapshotRecord {       // one planner block as captured by the snapshot
+    uint32_t linenum;
+    uint8_t buffer_state;
+    uint8_t block_type;
+    uint8_t limit;
+    float length;
+    float block_time;
+    float entry_vmax;
+    float cruise_vmax;
+    float exit_vmax;
+    float entry_velocity;
+    float cruise_velocity;
+    float exit_velocity;
+    float cruise_vset;
+    float junction_vmax;
+    float head_length;
+    float body_length;
+    float tail_length;
+} mpSnapshotRecord_t;
+
+typedef struct mpSnapshot {
+    bool requested;                     // capture pending
+    bool active;                        // readout in progress
+    uint8_t count;                      // blocks captured
+    uint8_t cursor;                     // next block to stream
+    mpSnapshotRecord_t record[PLANNER_QUEUE_SIZE];
+} mpSnapshot_t;
+static mpSnapshot_t qs;
+
+enum {                                  // limit codes reported in the snapshot
+    QS_LIMIT_NONE = 0,
+    QS_LIMIT_FEEDRATE,
+    QS_LIMIT_OVERRIDE,
+    QS_LIMIT_JUNCTION,
+    QS_LIMIT_JERK
+};
+
+static void _snapshot_block(mpSnapshotRecord_t *s, const mpBuf_t *bf, bool first)
+{
+    memset(s, 0, sizeof(mpSnapshotRecord_t));   // so records can be compared with memcmp()
+    s->linenum = bf->gm.linenum;
+    s->buffer_state = bf->buffer_state;
+    s->block_type = bf->block_type;
+    s->length = bf->length;
+    s->block_time = bf->block_time;
+    s->entry_vmax = first ? mr->entry_velocity : bf->pv->exit_vmax;
+    s->cruise_vmax = bf->cruise_vmax;
+    s->exit_vmax = bf->exit_vmax;
+    s->entry_velocity = first ? mr->entry_velocity : bf->pv->exit_velocity;
+    s->cruise_velocity = bf->cruise_velocity;
+    s->exit_velocity = bf->exit_velocity;
+    s->cruise_vset = bf->cruise_vset;
+    s->junction_vmax = bf->junction_vmax;
+    if (bf->buffer_state == MP_BUFFER_RUNNING) {
+        s->head_length = mr->r->head_length;
+        s->body_length = mr->r->body_length;
+        s->tail_length = mr->r->tail_length;
+    }
+}
+
+// Returns the number of blocks captured into <records> starting at the run buffer
+static uint8_t _snapshot_queue(mpSnapshotRecord_t *records, mpBuf_t **start)
+{
+    mpBuf_t *bf = mp->q.r;
+    *start = bf;
+    uint8_t count = 0;
+    while ((count < mp->q.queue_size) && (bf->buffer_state > MP_BUFFER_INITIALIZING)) {
+        _snapshot_block(&records[count], bf, (count == 0));
+        count++;
+        bf = bf->nx;
+    }
+    return (count);
+}
+
+static bool _snapshot_is_stable(mpBuf_t *start, uint8_t count)
+{
+    mpSnapshotRecord_t check;
+    mpBuf_t *bf = start;
+    if (mp->q.r != start) {
+        return (false);
+    }
+    for (uint8_t i=0; i<count; i++, bf = bf->nx) {
+        if (bf->buffer_state <= MP_BUFFER_INITIALIZING) {
+            return (false);
+        }
+        _snapshot_block(&check, bf, (i == 0));
+        if (memcmp(&check, &qs.record[i], sizeof(mpSnapshotRecord_t)) != 0) {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+// Fill in what the raw buffers don't carry: limit codes and head/body/tail estimates
+static void _snapshot_finalize(mpBuf_t *start)
+{
+    mpBuf_t *bf = start;
+    for (uint8_t i=0; i<qs.count; i++, bf = bf->nx) {
+        mpSnapshotRecord_t *s = &qs.record[i];
+        if ((s->block_type != BLOCK_TYPE_ALINE) || (s->buffer_state < MP_BUFFER_BACK_PLANNED)) {
+            continue;                                       // QS_LIMIT_NONE, no ramps
+        }
+        if (s->buffer_state != MP_BUFFER_RUNNING) {
+            s->head_length = mp_get_target_length(s->entry_velocity, s->cruise_velocity, bf);
+            s->tail_length = mp_get_target_length(s->exit_velocity, s->cruise_velocity, bf);
+            s->body_length = max(s->length - s->head_length - s->tail_length, 0.0f);
+        }
+        if (VELOCITY_LT(s->cruise_velocity, s->cruise_vmax)) {
+            s->limit = QS_LIMIT_JERK;
+        } else if (VELOCITY_LT(s->exit_velocity, s->cruise_velocity) && VELOCITY_EQ(s->exit_velocity, s->junction_vmax)) {
+            s->limit = QS_LIMIT_JUNCTION;
+        } else if (VELOCITY_LT(s->cruise_vmax, s->cruise_vset)) {
+            s->limit = QS_LIMIT_OVERRIDE;
+        } else {
+            s->limit = QS_LIMIT_FEEDRATE;
+        }
+    }
+}
+
+stat_t mp_get_qs(nvObj_t *nv)
+{
+    mpBuf_t *bf = mp->q.r;
+    uint8_t count = 0;
+    while ((count < mp->q.queue_size) && (bf->buffer_state > MP_BUFFER_INITIALIZING)) {
+        count++;
+        bf = bf->nx;
+    }
+    nv->value_int = count;
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
+stat_t mp_set_qs(nvObj_t *nv)
+{
+    qs.requested = true;
+    qs.active = false;
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
+static const char fmt_qs_json[] = "{\"qs\":%d}\n";
+static const char fmt_qs_text[] = "[qs]  planner blocks captured%8d\n";
+
+stat_t mp_queue_snapshot_callback()
+{
+    if (!qs.requested && !qs.active) {
+        return (STAT_NOOP);
+    }
+    if (!xio_connected()) {
+        qs.requested = false;
+        qs.active = false;
+        return (STAT_NOOP);
+    }
+    if (qs.requested) {
+        mpBuf_t *start;
+        qs.count = _snapshot_queue(qs.record, &start);
+        if (!_snapshot_is_stable(start, qs.count)) {
+            return (STAT_EAGAIN);                   // runtime moved underneath us - try again
+        }
+        _snapshot_finalize(start);
+        qs.requested = false;
+        qs.active = true;
+        qs.cursor = 0;
+    }
+    if (xio_tx_backed_up()) {                       // wait for the host to catch up
+        return (STAT_EAGAIN);
+    }
+    for (uint8_t i=0; (i < PLANNER_SNAPSHOT_LINES_PER_PASS) && (qs.cursor < qs.count); i++) {
+        mpSnapshotRecord_t *s = &qs.record[qs.cursor];
+        sprintf(cs.out_buf,
+                (js.json_mode == TEXT_MODE) ?
+                "[qs] %d %lu %d %d %d %0.4f %0.3f %0.1f %0.1f %0.1f %0.1f %0.1f %0.1f %0.4f %0.4f %0.4f\n" :
+                "{\"qs\":[%d,%lu,%d,%d,%d,%0.4f,%0.3f,%0.1f,%0.1f,%0.1f,%0.1f,%0.1f,%0.1f,%0.4f,%0.4f,%0.4f]}\n",
+                (int)qs.cursor, (unsigned long)s->linenum, (int)s->buffer_state, (int)s->block_type, (int)s->limit,
+                s->length, s->block_time * 60000, s->entry_vmax, s->cruise_vmax, s->exit_vmax,
+                s->entry_velocity, s->cruise_velocity, s->exit_velocity,
+                s->head_length, s->body_length, s->tail_length);
+        xio_writeline(cs.out_buf);
+        qs.cursor++;
+    }
+    if (qs.cursor < qs.count) {
+        return (STAT_EAGAIN);                       // more to send
+    }
+    qs.active = false;
+    sprintf(cs.out_buf, (js.json_mode == TEXT_MODE) ? fmt_qs_text : fmt_qs_json, (int)qs.count);
+    xio_writeline(cs.out_buf);
+    return (STAT_OK);
+}
+
 
 /************************************************************************************
  *** DIAGNOSTICS ********************************************************************
@@ -79,8 +79,9 @@
  *  - mp_aline()         - plan and queue a move with acceleration management
  *  - mp_dwell()         - plan and queue a pause (dwell) to the planner queue
  *  - mp_queue_command() - queue a canned command
- *  - mp_json_command()  - queue a JSON command for run-time interpretation and execution (M100)  
+ *  - mp_json_command()  - queue a JSON command, pre-compiled where possible, for run-time execution (M100)
  *  - mp_json_wait()     - queue a JSON wait for run-time interpretation and execution (M101)
+ *  - mp_input_wait()    - queue a wait on a digital input (M66)
  *  - 
  * In addition, cm_arc_feed() valaidates and sets up a arc paramewters and calls mp_aline() 
  * repeatedly to spool out the arc segments into the planner queue.
@@ -226,11 +227,24 @@ typedef enum {                      // code blocks for planning and trapezoid ge
     ASYMMETRIC_BUMP,                // (Ve != Vx) < Vc
 } blockHint;
 
+typedef enum {                      // M66 L word - input wait modes
+    INPUT_WAIT_IMMEDIATE = 0,       // read the input and continue
+    INPUT_WAIT_RISE,                // wait for the input to go active
+    INPUT_WAIT_FALL,                // wait for the input to go inactive
+    INPUT_WAIT_HIGH,                // wait until the input is active (returns at once if it already is)
+    INPUT_WAIT_LOW,                 // wait until the input is inactive (returns at once if it already is)
+    INPUT_WAIT_MODE_MAX = INPUT_WAIT_LOW,
+    INPUT_WAIT_SPINDLE_INDEX        // G33 - wait for the spindle index pulse (internal, not an M66 mode)
+} inputWaitMode;
+
 /*** Most of these factors are the result of a lot of tweaking. Change with caution.***/
 
 #define PLANNER_QUEUE_SIZE          ((uint8_t)48)       // Suggest 12 min. Limit is 255
 #define SECONDARY_QUEUE_SIZE        ((uint8_t)12)       // Secondary planner queue for feedhold operations
 #define PLANNER_BUFFER_HEADROOM     ((uint8_t)4)        // Buffers to reserve in planner before processing new input line
+#define PLANNER_SNAPSHOT_LINES_PER_PASS 4                 // planner queue snapshot blocks streamed per main loop pass
+#define INVERSE_TIME_TOLERANCE      ((float)0.005)      // G93 planned time may exceed programmed time by this fraction
+#define INVERSE_TIME_ITERATIONS     4                   // G93 cruise velocity corrections per block
 #define JERK_MULTIPLIER             ((float)1000000)    // DO NOT CHANGE - must always be 1 million
 
 #define JUNCTION_INTEGRATION_MIN    (0.05)              // JT minimum allowable setting
@@ -262,6 +276,13 @@ typedef enum {                      // code blocks for planning and trapezoid ge
 #define TRAVERSE_OVERRIDE_MAX       (1.00)              // 100% maximum
 #define TRAVERSE_OVERRIDE_FACTOR    (1.00)              // initial value
 
+#define INPUT_WAIT_POLL_MS          ((float)100.0)      // longest dwell an input wait (M66, M101) sleeps between checks
+
+#define SPINDLE_SYNC_CORRECTION_MS  ((float)50.0)       // G33 phase errors are closed over about this time
+#define SPINDLE_SYNC_MAX_CORRECTION ((float)0.20)       // limit phase correction to this fraction of a segment
+#define SPINDLE_SYNC_MAX_STRETCH    ((float)8.0)        // limit slowing segments for a slow or stalled spindle
+#define SPINDLE_SYNC_MAX_SPEEDUP    ((float)1.25)       // limit speeding segments up for a fast spindle
+
 //// Specialized equalities for comparing velocities with tolerances
 //// These determine allowable velocity discontinuities between blocks (among other tests)
 //// RG: Simulation shows +-0.001 is about as much as we should allow.
@@ -360,6 +381,8 @@ typedef struct mpBuffer {
     // is also the maximum entry velocity of the next move
 
     float absolute_vmax;                // fastest this block can move w/o exceeding constraints
+    float inverse_time;                 // G93 programmed block time in minutes, 0 if not G93
+    float inverse_vmax;                 // fastest the rate-limiting axis allows - ceiling for G93 time compensation
     float junction_vmax;                // maximum the exit velocity can be to go through the junction
     // between the NEXT BLOCK AND THIS ONE
 
@@ -403,6 +426,8 @@ typedef struct mpBuffer {
         cruise_vmax = 0.0;
         exit_vmax = 0.0;
         absolute_vmax = 0.0;
+        inverse_time = 0.0;
+        inverse_vmax = 0.0;
         junction_vmax = 0.0;
         jerk = 0.0;
         jerk_sq = 0.0;
@@ -418,7 +443,8 @@ typedef struct mpPlannerQueue {         // control structure for queue
     mpBuf_t *r;                         // run buffer pointer
     mpBuf_t *w;                         // write buffer pointer
     uint8_t queue_size;                 // total number of buffers, one-based (e.g. 48 not 47)
-    uint8_t buffers_available;          // running count of available buffers in queue
+    std::atomic<uint8_t> buffers_available; // running count of available buffers - changed by main loop and exec interrupt
+    std::atomic<uint8_t> buffers_in_run;    // committed buffers not yet freed by the exec (queued or running)
     mpBuf_t *bf;                        // pointer to buffer pool (storage array)
     magic_t magic_end;
 } mpPlannerQueue_t;
@@ -511,7 +537,7 @@ typedef struct mpPlanner {              // common variables for a planner contex
     float position[AXES];               // final move position for planning purposes
 
     // timing variables
-    float run_time_remaining;           // time left in runtime (including running block)
+    std::atomic<float> run_time_remaining; // time left in runtime (including running block) - written only by exec
     float plannable_time;               // time in planner that can actually be planned
 
     // planner state variables
@@ -588,6 +614,9 @@ stat_t mp_runtime_command(mpBuf_t *bf);
 stat_t mp_json_command(char *json_string);
 stat_t mp_json_command_immediate(char *json_string);
 stat_t mp_json_wait(char *json_string);
+stat_t mp_input_wait(const uint8_t input, const inputWaitMode mode, const float timeout);
+void mp_input_changed(const uint8_t input, const bool active);
+stat_t mp_input_wait_callback(void);
 
 stat_t mp_dwell(const float seconds);
 void mp_end_dwell(void);
@@ -595,17 +624,20 @@ void mp_request_out_of_band_dwell(float seconds);
 
 //**** planner functions and helpers
 uint8_t mp_get_planner_buffers(const mpPlanner_t *_mp);
+uint8_t mp_get_buffers_in_run(const mpPlanner_t *_mp);
 bool mp_planner_is_full(const mpPlanner_t *_mp);
 bool mp_has_runnable_buffer(const mpPlanner_t *_mp);
 bool mp_is_phat_city_time(void);
 
 stat_t mp_planner_callback();
+void mp_input_line_received(void);
 void mp_replan_queue(mpBuf_t *bf);
 void mp_start_feed_override(const float ramp_time, const float override);
 void mp_end_feed_override(const float ramp_time);
 void mp_start_traverse_override(const float ramp_time, const float override);
 void mp_end_traverse_override(const float ramp_time);
 void mp_planner_time_accounting(void);
+float mp_get_planner_time(const mpPlanner_t *_mp);
 
 //**** planner buffer primitives
 //void mp_init_planner_buffers(void);
@@ -653,8 +685,14 @@ float mp_calc_j(const float t, const float v_0, const float v_1, const float T);
 stat_t mp_forward_plan(void);
 stat_t mp_exec_move(void);
 stat_t mp_exec_aline(mpBuf_t *bf);
+stat_t mp_inverse_time_callback(void);
+stat_t mp_spindle_sync_callback(void);
 void mp_exit_hold_state(void);
 
 void mp_dump_planner(mpBuf_t *bf_start);
 
+stat_t mp_get_qs(nvObj_t *nv);
+stat_t mp_set_qs(nvObj_t *nv);
+stat_t mp_queue_snapshot_callback(void);
+
 #endif    // End of include Guard: PLANNER_H_ONCE
@@ -41,6 +41,7 @@
 
 srSingleton_t sr;
 qrSingleton_t qr;
+jpSingleton_t jp;
 
 /**** Exception Reports ************************************************************
  *
@@ -167,6 +168,10 @@ void rpt_print_system_ready_message(void)
  */
 static stat_t _populate_unfiltered_status_report(void);
 static uint8_t _populate_filtered_status_report(void);
+static bool _status_report_value_changed(uint8_t i, nvObj_t *nv);
+#ifdef __TEXT_MODE
+static uint8_t _emit_text_status_report(bool verbose);
+#endif
 
 uint8_t _is_stat(nvObj_t *nv)
 {
@@ -297,6 +302,12 @@ stat_t sr_status_report_callback()         // called by controller dispatcher
         return (STAT_NOOP);
     }
 
+    // hold the request while the host is behind on output - one report with the
+    // latest values goes out once it catches up
+    if (xio_tx_backed_up()) {
+        return (STAT_NOOP);
+    }
+
    // don't send an SR if you the planner is experiencing a time constraint
    if (!mp_is_phat_city_time()) {
         if (++sr.throttle_counter != SR_THROTTLE_COUNT) {
@@ -306,6 +317,13 @@ stat_t sr_status_report_callback()         // called by controller dispatcher
     }
 
     sr.status_report_request = SR_OFF;
+#ifdef __TEXT_MODE
+    if (js.json_mode == TEXT_MODE) {
+        _emit_text_status_report((sr.status_report_request == SR_VERBOSE) ||
+                                 (sr.status_report_verbosity == SR_VERBOSE));
+        return (STAT_OK);
+    }
+#endif
     if ((sr.status_report_request == SR_VERBOSE) ||
         (sr.status_report_verbosity == SR_VERBOSE)) {
         _populate_unfiltered_status_report();
@@ -323,6 +341,12 @@ stat_t sr_status_report_callback()         // called by controller dispatcher
  */
 stat_t sr_run_text_status_report()
 {
+#ifdef __TEXT_MODE
+    if (js.json_mode == TEXT_MODE) {
+        _emit_text_status_report(true);
+        return (STAT_OK);
+    }
+#endif
     _populate_unfiltered_status_report();
     nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_RESPONSE_FORMAT);
     return (STAT_OK);
@@ -377,12 +401,7 @@ static uint8_t _populate_filtered_status_report()
     const char sr_str[] = "sr";
     bool has_data = false;
     char tmp[TOKEN_LEN+1];
-    float current_value;
     nvObj_t *nv = nv_reset_nv_list();           // sets nv to the start of the body
-    
-    // Set thresholds to detect value changes based on precision for the value. 
-    // Allow for floating point roundoffs, i.e. precision = 2 is 0.01 becomes --> 0.009
-    float precision[8] = { 0.9, 0.09, 0.009, 0.0009, 0.00009, 0.000009, 0.0000009, 0.00000009 };
 
     nv->valuetype = TYPE_PARENT;                // setup the parent object (no need to length check the copy)
     strcpy(nv->token, sr_str);
@@ -395,24 +414,10 @@ static uint8_t _populate_filtered_status_report()
         }
         nv_get_nvObj(nv);
 
-        // extract the value and cast into a float, regardless of value type 
-        if ((valueType)(cfgArray[nv->index].flags & F_TYPE_MASK) == TYPE_FLOAT) {
-            current_value = nv->value_flt;
-        } else {
-            current_value = (float)nv->value_int;
-        }
-
-        // report values that have changed by more than the indicated precision, but always stops and ends
-        if ((fabs(current_value - sr.status_report_value[i]) > precision[cfgArray[nv->index].precision]) ||
-//            ((nv->index == sr.stat_index) && fp_EQ(nv->value_int, COMBINED_PROGRAM_STOP)) ||
-//            ((nv->index == sr.stat_index) && fp_EQ(nv->value_int, COMBINED_PROGRAM_END))) {
-            ((nv->index == sr.stat_index) && (nv->value_int == COMBINED_PROGRAM_STOP)) ||
-            ((nv->index == sr.stat_index) && (nv->value_int == COMBINED_PROGRAM_END))) {
-
+        if (_status_report_value_changed(i, nv)) {
             strcpy(tmp, nv->group);            // flatten out groups - WARNING - you cannot use strncpy here...
             strcat(tmp, nv->token);
             strcpy(nv->token, tmp);            //...or here.
-            sr.status_report_value[i] = current_value;
             if ((nv = nv->nx) == NULL) {        // should never be NULL unless SR length exceeds available buffer array
                 return (false); 
             }
@@ -424,6 +429,133 @@ static uint8_t _populate_filtered_status_report()
     return (has_data);
 }
 
+/*
+ * _status_report_value_changed() - filter test for element i of the status report
+ *
+ *  Returns true if the value in nv has changed by more than the precision of the element
+ *  since it was last reported, and records the new value. Program stops and ends are
+ *  always reported.
+ */
+static bool _status_report_value_changed(uint8_t i, nvObj_t *nv)
+{
+    // Set thresholds to detect value changes based on precision for the value.
+    // Allow for floating point roundoffs, i.e. precision = 2 is 0.01 becomes --> 0.009
+    static const float precision[8] = { 0.9, 0.09, 0.009, 0.0009, 0.00009, 0.000009, 0.0000009, 0.00000009 };
+    float current_value;
+
+    // extract the value and cast into a float, regardless of value type
+    if ((valueType)(cfgArray[nv->index].flags & F_TYPE_MASK) == TYPE_FLOAT) {
+        current_value = nv->value_flt;
+    } else {
+        current_value = (float)nv->value_int;
+    }
+
+    // report values that have changed by more than the indicated precision, but always stops and ends
+    if ((fabs(current_value - sr.status_report_value[i]) > precision[cfgArray[nv->index].precision]) ||
+        ((nv->index == sr.stat_index) && (nv->value_int == COMBINED_PROGRAM_STOP)) ||
+        ((nv->index == sr.stat_index) && (nv->value_int == COMBINED_PROGRAM_END))) {
+        sr.status_report_value[i] = current_value;
+        return (true);
+    }
+    return (false);
+}
+
+/*
+ * Text mode status report emitter
+ *
+ * _compile_text_status_report() - resolve the SR list into pre-formed text report elements
+ * _emit_text_status_report()    - generate a text mode status report without using the nv list
+ *
+ *  The general path builds the report as an nv list - resetting the list, copying and
+ *  stripping tokens for each element in nv_get_nvObj(), flattening group+token, then
+ *  walking the list again to print it. In text mode none of that list is needed after
+ *  printing, so the tokens are resolved once when the SR list changes, and each report
+ *  runs the get() and print() bindings directly on a single scratch nvObj. Filtered
+ *  elements are skipped before they are formatted, and each line goes out to the TX
+ *  buffer as soon as it is printed.
+ *
+ *  Output is identical to the nv list path: the same bindings, unit conversion, filtering
+ *  and ordering are used, including the NV_BODY_LEN-2 element limit and stop-on-empty
+ *  behavior of text_print_multiline_formatted().
+ *
+ *  The SR list can be changed by sr_set_status_report(), sr_init_status_report() or
+ *  directly through the se00-se39 persistence entries, so the compiled list is checked
+ *  against the SR list on each report rather than relying on every writer to invalidate it.
+ */
+#ifdef __TEXT_MODE
+
+static void _compile_text_status_report()
+{
+    sr.text_report_len = 0;
+    for (uint8_t i=0; i<NV_STATUS_REPORT_LEN; i++) {
+        index_t index = sr.status_report_list[i];
+        if ((index == 0) || (index >= nv_index_max())) { break;}
+        srTextItem_t *item = &sr.text_report[i];
+        const cfgItem_t *cfg_item = &cfgArray[index];
+
+        item->index = index;
+        strcpy(item->group, cfg_item->group);               // same stripping rules as nv_get_nvObj()
+        strcpy(item->token, cfg_item->token);
+        if (item->group[0] != NUL) {
+            if (cfg_item->flags & F_NOSTRIP) {
+                item->group[0] = NUL;
+            } else {
+                strcpy(item->token, &cfg_item->token[strlen(item->group)]);
+            }
+        }
+        strcpy(item->flat, item->group);                    // same flattening as the SR populate functions
+        strcat(item->flat, item->token);
+        sr.text_report_len++;
+    }
+    memcpy(sr.text_report_source, sr.status_report_list, sizeof(sr.text_report_source));
+}
+
+static uint8_t _emit_text_status_report(bool verbose)
+{
+    nvObj_t nv_scratch;
+    nvObj_t *nv = &nv_scratch;
+    uint8_t printed = 0;
+    bool printing = true;
+
+    if (memcmp(sr.text_report_source, sr.status_report_list, sizeof(sr.text_report_source)) != 0) {
+        _compile_text_status_report();
+    }
+    nvStr.wp = 0;                                           // string values are only needed until printed
+    nv->pv = NULL;
+    nv->nx = NULL;
+    nv->depth = 1;
+
+    for (uint8_t i=0; i<sr.text_report_len; i++) {
+        srTextItem_t *item = &sr.text_report[i];
+
+        nv->index = item->index;
+        nv->valuetype = TYPE_EMPTY;
+        nv->value_int = 0;
+        nv->value_flt = 0;
+        nv->precision = 0;
+        nv->stringp = NULL;
+        strcpy(nv->group, item->group);
+        strcpy(nv->token, item->token);
+        ((fptrCmd)cfgArray[nv->index].get)(nv);             // populate the value
+
+        if (!verbose && !_status_report_value_changed(i, nv)) {
+            continue;
+        }
+        if ((nv->valuetype == TYPE_EMPTY) || (printed >= NV_BODY_LEN-2)) {
+            printing = false;                               // the list printer stops at an empty object...
+        }
+        if (!printing) {                                    //...but the filter state is kept current
+            continue;
+        }
+        strcpy(nv->token, item->flat);
+        convert_outgoing_float(nv);
+        nv_print(nv);
+        printed++;
+    }
+    return (printed);
+}
+
+#endif // __TEXT_MODE
 
 /****************************
  * END OF REPORT FUNCTIONS *
@@ -541,29 +673,36 @@ stat_t qr_queue_report_callback()         // called by controller dispatcher
     if ((qr.queue_report_verbosity == QR_OFF) ||
         (js.json_verbosity == JV_SILENT) ||
         (qr.queue_report_requested == false) ||
+        (xio_tx_backed_up()) ||             // coalesce while the host is behind on output
         (!mp_is_phat_city_time())) {
         return (STAT_NOOP);
     }
 
     qr.queue_report_requested = false;
 
+    // take and reset the counts in one step so changes made by the exec interrupt
+    // between the report and the reset are not lost
+    int buffers_added = qr.buffers_added.exchange(0);
+    int buffers_removed = qr.buffers_removed.exchange(0);
+    int buffers_available = qr.buffers_available;
+
     char report[32];    // we know these reports can't be longer than 30 bytes
 
     if (cs.comm_mode == TEXT_MODE) {
         if (qr.queue_report_verbosity == QR_SINGLE) {
-            sprintf(report, "qr:%d\n", qr.buffers_available);
+            sprintf(report, "qr:%d\n", buffers_available);
         } else  {
-            sprintf(report, "qr:%d, qi:%d, qo:%d\n", qr.buffers_available,qr.buffers_added,qr.buffers_removed);
+            sprintf(report, "qr:%d, qi:%d, qo:%d\n", buffers_available, buffers_added, buffers_removed);
         }
     } else {
         if (qr.queue_report_verbosity == QR_SINGLE) {
-            sprintf(report, "{\"qr\":%d}\n", qr.buffers_available);
+            sprintf(report, "{\"qr\":%d}\n", buffers_available);
         } else {
-            sprintf(report, "{\"qr\":%d,\"qi\":%d,\"qo\":%d}\n", qr.buffers_available, qr.buffers_added,qr.buffers_removed);
+            sprintf(report, "{\"qr\":%d,\"qi\":%d,\"qo\":%d}\n", buffers_available, buffers_added, buffers_removed);
         }
     }
-    xio_writeline(report);
-    qr_init_queue_report();
+    xio_writeline(report, false, XIO_TX_REPORT);
+    qr.init_tick = SysTickTimer_getValue();     // counts were taken and reset above
     return (STAT_OK);
 }
 
@@ -599,23 +738,102 @@ stat_t qr_get(nvObj_t *nv)
 
 stat_t qi_get(nvObj_t *nv)
 {
-    nv->value_int = qr.buffers_added;
+    nv->value_int = qr.buffers_added.exchange(0);  // read and reset it
     nv->valuetype = TYPE_INTEGER;
-    qr.buffers_added = 0;                // reset it
     return (STAT_OK);
 }
 
 stat_t qo_get(nvObj_t *nv)
 {
-    nv->value_int = qr.buffers_removed;
+    nv->value_int = qr.buffers_removed.exchange(0);// read and reset it
     nv->valuetype = TYPE_INTEGER;
-    qr.buffers_removed = 0;                // reset it
     return (STAT_OK);
 }
 
 stat_t qr_get_qv(nvObj_t *nv) { return(get_integer(nv, (uint8_t &)qr.queue_report_verbosity)); }
 stat_t qr_set_qv(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)qr.queue_report_verbosity, QR_OFF, QR_TRIPLE)); }
 
+/*****************************************************************************
+ * JOB PROGRESS REPORTS
+ *
+ *  The host declares the number of lines in the job by setting jtot, which also
+ *  restarts the accounting. From then on the gcode parser counts lines consumed and
+ *  the runtime accumulates executed time. Time remaining is the time queued in the
+ *  planner plus the lines not yet sent, costed at the average time per line so far.
+ *  All values are read-only except jtot, and can be placed in status reports.
+ *
+ *  Executed time is kept in integer microseconds. Segments are about 1.25e-5 minutes, which
+ *  a float counted in minutes can no longer add after a few hours of running. The counter
+ *  is written by the exec interrupt, so the main loop reads and clears it with interrupts
+ *  masked - a 64 bit access is not atomic.
+ *
+ *  jp_add_executed_time()  - add time run by the exec (minutes). Called from the exec interrupt
+ *  jp_get_executed_time()  - time executed since the job was declared (minutes)
+ *  jp_get_time_remaining() - estimated time to finish the job (minutes)
+ *  jp_get_jtot()           - get host-declared total lines
+ *  jp_set_jtot()           - declare total lines and restart job progress accounting
+ *  jp_get_jlin()           - get lines consumed
+ *  jp_get_jext()           - get executed time (seconds)
+ *  jp_get_jrem()           - get estimated time remaining (seconds)
+ *  jp_get_jprg()           - get job progress (percent)
+ */
+
+void jp_add_executed_time(const float minutes)
+{
+    jp.executed_usec += (uint32_t)(minutes * 60000000 + 0.5);
+}
+
+float jp_get_executed_time()
+{
+    __disable_irq();
+    uint64_t executed_usec = jp.executed_usec;
+    __enable_irq();
+    return ((float)executed_usec / 60000000);
+}
+
+float jp_get_time_remaining()
+{
+    float queued_time = mp_get_planner_time(mp);
+
+    if ((jp.lines_consumed > 0) && (jp.lines_total > jp.lines_consumed)) {
+        float line_time = (jp_get_executed_time() + queued_time) / jp.lines_consumed;
+        return (queued_time + line_time * (jp.lines_total - jp.lines_consumed));
+    }
+    return (queued_time);
+}
+
+stat_t jp_get_jtot(nvObj_t *nv) { return(get_integer(nv, jp.lines_total)); }
+stat_t jp_get_jlin(nvObj_t *nv) { return(get_integer(nv, jp.lines_consumed)); }
+
+stat_t jp_set_jtot(nvObj_t *nv)
+{
+    ritorno(set_int32(nv, jp.lines_total, 0, MAX_LINENUM));
+    jp.lines_consumed = 0;
+    __disable_irq();
+    jp.executed_usec = 0;
+    __enable_irq();
+    return (STAT_OK);
+}
+
+stat_t jp_get_jext(nvObj_t *nv) { return(get_float(nv, jp_get_executed_time() * 60)); }
+stat_t jp_get_jrem(nvObj_t *nv) { return(get_float(nv, jp_get_time_remaining() * 60)); }
+
+stat_t jp_get_jprg(nvObj_t *nv)
+{
+    float progress = 0;
+
+    if (jp.lines_total > 0) {
+        float executed_time = jp_get_executed_time();
+        float total_time = executed_time + jp_get_time_remaining();
+        if (total_time > 0) {
+            progress = 100 * executed_time / total_time;
+        } else if (jp.lines_consumed >= jp.lines_total) {
+            progress = 100;
+        }
+    }
+    return(get_float(nv, progress));
+}
+
 /*****************************************************************************
  * JOB ID REPORTS
  *
@@ -702,4 +920,16 @@ void qr_print_qi(nvObj_t *nv) { text_print(nv, fmt_qi);}    // TYPE_INT
 void qr_print_qo(nvObj_t *nv) { text_print(nv, fmt_qo);}    // TYPE_INT
 void qr_print_qv(nvObj_t *nv) { text_print(nv, fmt_qv);}    // TYPE_INT
 
+static const char fmt_jtot[] = "Job lines total:%12lu\n";
+static const char fmt_jlin[] = "Job lines consumed:%9lu\n";
+static const char fmt_jext[] = "Job time executed:%12.1f sec\n";
+static const char fmt_jrem[] = "Job time remaining:%11.1f sec\n";
+static const char fmt_jprg[] = "Job progress:%16.1f%%\n";
+
+void jp_print_jtot(nvObj_t *nv) { text_print(nv, fmt_jtot);}  // TYPE_INT
+void jp_print_jlin(nvObj_t *nv) { text_print(nv, fmt_jlin);}  // TYPE_INT
+void jp_print_jext(nvObj_t *nv) { text_print(nv, fmt_jext);}  // TYPE_FLOAT
+void jp_print_jrem(nvObj_t *nv) { text_print(nv, fmt_jrem);}  // TYPE_FLOAT
+void jp_print_jprg(nvObj_t *nv) { text_print(nv, fmt_jprg);}  // TYPE_FLOAT
+
 #endif // __TEXT_MODE
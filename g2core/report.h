@@ -57,6 +57,13 @@ typedef enum {                      // planner queue enable and verbosity
     QR_TRIPLE                       // queue depth reported for buffers, buffers added, buffered removed
 } qrVerbosity;
 
+typedef struct srTextItem {         // pre-resolved status report element for text mode reports
+    index_t index;                  // cfgArray index of the element
+    char group[GROUP_LEN+1];        // group as presented to the get() and print() bindings
+    char token[TOKEN_LEN+1];        // group-stripped token as presented to get()
+    char flat[TOKEN_LEN+1];         // flattened group+token as presented to print()
+} srTextItem_t;
+
 typedef struct srSingleton {
 
     /*** config values (PUBLIC) ***/
@@ -71,6 +78,9 @@ typedef struct srSingleton {
     index_t status_report_list[NV_STATUS_REPORT_LEN];   // status report elements to report
     float status_report_value[NV_STATUS_REPORT_LEN];    // previous values for filtered reporting
 
+    uint8_t text_report_len;                            // number of compiled text report elements
+    index_t text_report_source[NV_STATUS_REPORT_LEN];   // SR list the text report was compiled from
+    srTextItem_t text_report[NV_STATUS_REPORT_LEN];     // compiled text report elements
 } srSingleton_t;
 
 typedef struct qrSingleton {        // data for queue reports
@@ -80,19 +90,31 @@ typedef struct qrSingleton {        // data for queue reports
 
     /*** runtime values (PRIVATE) ***/
     uint8_t queue_report_requested;         // set to true to request a report
-    uint8_t buffers_available;              // stored buffer depth passed to by callback
+    std::atomic<uint8_t> buffers_available; // stored buffer depth - written at exec interrupt level
     uint8_t prev_available;                 // buffers available at last count
-    uint16_t buffers_added;                 // buffers added since last count
-    uint16_t buffers_removed;               // buffers removed since last report
+    std::atomic<uint16_t> buffers_added;    // buffers added since last count (main loop)
+    std::atomic<uint16_t> buffers_removed;  // buffers removed since last report (exec interrupt)
     uint8_t motion_mode;                    // used to detect arc movement
     uint32_t init_tick;                     // time when values were last initialized or cleared
 
 } qrSingleton_t;
 
+typedef struct jpSingleton {        // data for job progress reports
+
+    /*** config values (PUBLIC) ***/
+    int32_t lines_total;                    // host-declared number of lines in the job (0 = not declared)
+
+    /*** runtime values (PRIVATE) ***/
+    int32_t lines_consumed;                 // lines taken by the gcode parser since the job was declared
+    volatile uint64_t executed_usec;        // time executed by the runtime since the job was declared (exec interrupt)
+
+} jpSingleton_t;
+
 /**** Externs - See report.c for allocation ****/
 
 extern srSingleton_t sr;
 extern qrSingleton_t qr;
+extern jpSingleton_t jp;
 
 /**** Function Prototypes ****/
 
@@ -132,6 +154,16 @@ stat_t qo_get(nvObj_t *nv);
 stat_t qr_get_qv(nvObj_t *nv);
 stat_t qr_set_qv(nvObj_t *nv);
 
+void jp_add_executed_time(const float minutes);
+float jp_get_executed_time(void);
+float jp_get_time_remaining(void);
+stat_t jp_get_jtot(nvObj_t *nv);
+stat_t jp_set_jtot(nvObj_t *nv);
+stat_t jp_get_jlin(nvObj_t *nv);
+stat_t jp_get_jext(nvObj_t *nv);
+stat_t jp_get_jrem(nvObj_t *nv);
+stat_t jp_get_jprg(nvObj_t *nv);
+
 #ifdef __TEXT_MODE
 
     void sr_print_sr(nvObj_t *nv);
@@ -141,6 +173,11 @@ stat_t qr_set_qv(nvObj_t *nv);
     void qr_print_qr(nvObj_t *nv);
     void qr_print_qi(nvObj_t *nv);
     void qr_print_qo(nvObj_t *nv);
+    void jp_print_jtot(nvObj_t *nv);
+    void jp_print_jlin(nvObj_t *nv);
+    void jp_print_jext(nvObj_t *nv);
+    void jp_print_jrem(nvObj_t *nv);
+    void jp_print_jprg(nvObj_t *nv);
 
 #else
 
@@ -151,6 +188,11 @@ stat_t qr_set_qv(nvObj_t *nv);
     #define qr_print_qr tx_print_stub
     #define qr_print_qi tx_print_stub
     #define qr_print_qo tx_print_stub
+    #define jp_print_jtot tx_print_stub
+    #define jp_print_jlin tx_print_stub
+    #define jp_print_jext tx_print_stub
+    #define jp_print_jrem tx_print_stub
+    #define jp_print_jprg tx_print_stub
 
 #endif // __TEXT_MODE
 
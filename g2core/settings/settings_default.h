@@ -74,6 +74,10 @@
 #define SOFT_LIMIT_ENABLE           0       // {sl: 0=off, 1=on
 #endif
 
+#ifndef TRAVERSE_UNCOORDINATED
+#define TRAVERSE_UNCOORDINATED      0       // {tru: 0=coordinated G0, 1=each axis at its own velocity max
+#endif
+
 #ifndef HARD_LIMIT_ENABLE
 #define HARD_LIMIT_ENABLE           1       // {lim: 0=off, 1=on
 #endif
@@ -133,6 +137,38 @@
 #define PROBE_REPORT_ENABLE         true    // {prbr: 
 #endif
 
+#ifndef TOOL_SETTER_Z
+#define TOOL_SETTER_Z               0       // {tsz: machine Z where a zero-length tool trips the tool setter
+#endif
+
+#ifndef TOOL_SETTER_FAST_FEED
+#define TOOL_SETTER_FAST_FEED       500     // {tsf: G37 fast approach feed rate, mm/min
+#endif
+
+#ifndef TOOL_SETTER_SLOW_FEED
+#define TOOL_SETTER_SLOW_FEED       25      // {tss: G37 slow latch feed rate, mm/min
+#endif
+
+#ifndef TOOL_SETTER_BACKOFF
+#define TOOL_SETTER_BACKOFF         2       // {tsb: G37 backoff from contact, mm
+#endif
+
+#ifndef PROBE_LATCH_FEED
+#define PROBE_LATCH_FEED            0       // {prlf: G38 slow latch feed rate, mm/min. 0 runs single-pass probes
+#endif
+
+#ifndef PROBE_LATCH_BACKOFF
+#define PROBE_LATCH_BACKOFF         1       // {prlb: G38 backoff from the fast contact before latching, mm
+#endif
+
+#ifndef PROBE_LATCH_SAMPLES
+#define PROBE_LATCH_SAMPLES         1       // {prln: number of latch samples averaged, 1 - PROBE_LATCH_SAMPLES_MAX
+#endif
+
+#ifndef PROBE_LATCH_TOLERANCE
+#define PROBE_LATCH_TOLERANCE       0       // {prlt: reject latch samples farther than this from the median, mm. 0 keeps all
+#endif
+
 #ifndef MANUAL_FEEDRATE_OVERRIDE_ENABLE
 #define MANUAL_FEEDRATE_OVERRIDE_ENABLE false
 #endif
@@ -193,6 +229,14 @@
 #define MARLIN_COMPAT_ENABLED       false                   // boolean, either true or false
 #endif
 
+#ifndef MARLIN_ADVANCED_OK
+#define MARLIN_ADVANCED_OK          false                   // true to report "ok N<line> P<planner> B<rx lines>" in Marlin mode
+#endif
+
+#ifndef MARLIN_RX_LINE_LENGTH
+#define MARLIN_RX_LINE_LENGTH       96                      // RX buffer space reserved per line when reporting free line slots (Marlin MAX_CMD_SIZE)
+#endif
+
 // *** Gcode Startup Defaults *** //
 
 #ifndef GCODE_DEFAULT_UNITS
@@ -233,6 +277,9 @@
 #ifndef M1_MICROSTEPS
 #define M1_MICROSTEPS               8                       // {1mi:  1,2,4,8,    16,32 (G2 ONLY)
 #endif
+#ifndef M1_MICROSTEPS_RAPID
+#define M1_MICROSTEPS_RAPID         0                       // {1mr:  0=disabled, or coarser microsteps used at high step rates
+#endif
 #ifndef M1_STEPS_PER_UNIT
 #define M1_STEPS_PER_UNIT           0                       // {1su:  steps to issue per unit of length or degrees of rotation
 #endif
@@ -251,6 +298,9 @@
 #ifndef M1_POWER_LEVEL
 #define M1_POWER_LEVEL              0.0                     // {1pl:   0.0=no power, 1.0=max power
 #endif
+#ifndef M1_POWER_LEVEL_CRUISE
+#define M1_POWER_LEVEL_CRUISE       0.0                     // {1pc:   0.0=use power level, or body and dwell power (TMC2130)
+#endif
 
 // MOTOR 2
 #ifndef M2_MOTOR_MAP
@@ -265,6 +315,9 @@
 #ifndef M2_MICROSTEPS
 #define M2_MICROSTEPS               8
 #endif
+#ifndef M2_MICROSTEPS_RAPID
+#define M2_MICROSTEPS_RAPID         0
+#endif
 #ifndef M2_STEPS_PER_UNIT
 #define M2_STEPS_PER_UNIT           0
 #endif
@@ -283,6 +336,9 @@
 #ifndef M2_POWER_LEVEL
 #define M2_POWER_LEVEL              0.0
 #endif
+#ifndef M2_POWER_LEVEL_CRUISE
+#define M2_POWER_LEVEL_CRUISE       0.0
+#endif
 
 // MOTOR 3
 #ifndef M3_MOTOR_MAP
@@ -297,6 +353,9 @@
 #ifndef M3_MICROSTEPS
 #define M3_MICROSTEPS               8
 #endif
+#ifndef M3_MICROSTEPS_RAPID
+#define M3_MICROSTEPS_RAPID         0
+#endif
 #ifndef M3_STEPS_PER_UNIT
 #define M3_STEPS_PER_UNIT           0
 #endif
@@ -315,6 +374,9 @@
 #ifndef M3_POWER_LEVEL
 #define M3_POWER_LEVEL              0.0
 #endif
+#ifndef M3_POWER_LEVEL_CRUISE
+#define M3_POWER_LEVEL_CRUISE       0.0
+#endif
 
 // MOTOR 4
 #ifndef M4_MOTOR_MAP
@@ -329,6 +391,9 @@
 #ifndef M4_MICROSTEPS
 #define M4_MICROSTEPS               8
 #endif
+#ifndef M4_MICROSTEPS_RAPID
+#define M4_MICROSTEPS_RAPID         0
+#endif
 #ifndef M4_STEPS_PER_UNIT
 #define M4_STEPS_PER_UNIT           0
 #endif
@@ -347,6 +412,9 @@
 #ifndef M4_POWER_LEVEL
 #define M4_POWER_LEVEL              0.0
 #endif
+#ifndef M4_POWER_LEVEL_CRUISE
+#define M4_POWER_LEVEL_CRUISE       0.0
+#endif
 
 // MOTOR 5
 #ifndef M5_MOTOR_MAP
@@ -361,6 +429,9 @@
 #ifndef M5_MICROSTEPS
 #define M5_MICROSTEPS               8
 #endif
+#ifndef M5_MICROSTEPS_RAPID
+#define M5_MICROSTEPS_RAPID         0
+#endif
 #ifndef M5_STEPS_PER_UNIT
 #define M5_STEPS_PER_UNIT           0
 #endif
@@ -379,6 +450,9 @@
 #ifndef M5_POWER_LEVEL
 #define M5_POWER_LEVEL              0.0
 #endif
+#ifndef M5_POWER_LEVEL_CRUISE
+#define M5_POWER_LEVEL_CRUISE       0.0
+#endif
 
 // MOTOR 6
 #ifndef M6_MOTOR_MAP
@@ -393,6 +467,9 @@
 #ifndef M6_MICROSTEPS
 #define M6_MICROSTEPS               8
 #endif
+#ifndef M6_MICROSTEPS_RAPID
+#define M6_MICROSTEPS_RAPID         0
+#endif
 #ifndef M6_STEPS_PER_UNIT
 #define M6_STEPS_PER_UNIT           0
 #endif
@@ -411,6 +488,9 @@
 #ifndef M6_POWER_LEVEL
 #define M6_POWER_LEVEL              0.0
 #endif
+#ifndef M6_POWER_LEVEL_CRUISE
+#define M6_POWER_LEVEL_CRUISE       0.0
+#endif
 
 //*****************************************************************************
 //*** Axis Settings ***********************************************************
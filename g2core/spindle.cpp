@@ -284,6 +284,7 @@ stat_t spindle_speed_immediate(float speed)
 stat_t spindle_speed_sync(float speed)
 {
     ritorno(_casey_jones(speed));
+    cm->gmx.spindle_speed = speed;          // the model's S, used to plan G33 moves
     float value[] = { speed };
     mp_queue_command(_exec_spindle_speed, value, nullptr);
     return (STAT_OK);
@@ -57,6 +57,8 @@ static stRunSingleton_t st_run;
 /**** Static functions ****/
 
 static void _load_move(void);
+static void _load_microstep_shift(const uint8_t motor);
+static void _load_motion_phase(const stMotionPhase motion_phase);
 
 /**** Setup motate ****/
 
@@ -129,9 +131,9 @@ void stepper_init()
     stepper_init_assertions();
 
     // setup DDA timer
-    // Longer duty cycles stretch ON pulses but 75% is about the upper limit and about
-    // optimal for 200 KHz DDA clock before the time in the OFF cycle is too short.
-    // If you need more pulse width you need to drop the DDA clock rate
+    // The DDA fires one interrupt per tick. Step pulses are ended by the following tick,
+    // so pulse width is one DDA period. If you need more pulse width you need to drop
+    // the DDA clock rate. See stepper.h for the timing budget.
     dda_timer.setInterrupts(kInterruptOnOverflow | kInterruptPriorityHighest);
 
     // setup software interrupt exec timer & initial condition
@@ -169,6 +171,9 @@ void stepper_reset()
         st_run.mot[motor].substep_accumulator = 0;      // will become max negative during per-motor setup;
         st_pre.mot[motor].corrected_steps = 0;          // diagnostic only - no action effect
     }
+    if (st_run.motion_phase != MOTION_PHASE_RAMP) {     // restore full run current
+        _load_motion_phase(MOTION_PHASE_RAMP);
+    }
     mp_set_steps_to_runtime_position();                 // reset encoder to agree with the above
 }
 
@@ -253,7 +258,7 @@ stat_t st_motor_power_callback()     // called by controller
 
 /*
  *  The DDA timer interrupt does this:
- *    - fire on overflow
+ *    - fire on overflow (once per DDA tick - there is no separate pulse-off interrupt)
  *    - clear interrupt condition
  *    - clear all step pins - this clears those the were set during the previous interrupt
  *    - if downcount == 0 and stop the timer and exit
@@ -468,6 +473,9 @@ static void _load_move()
         debug_trap_if_true((st_run.dda_ticks_downcount != 0), "_load_move() downcount is not zero");
         st_run.dda_ticks_downcount = st_pre.dda_ticks;
         st_run.dda_ticks_X_substeps = st_pre.dda_ticks_X_substeps;
+        if (st_pre.motion_phase != st_run.motion_phase) {
+            _load_motion_phase(st_pre.motion_phase);    // change run current on the section boundary
+        }
 
         // INLINED VERSION: 4.3us
         //**** MOTOR_1 LOAD ****
@@ -488,6 +496,11 @@ static void _load_move()
                 st_run.mot[MOTOR_1].substep_accumulator *= st_pre.mot[MOTOR_1].accumulator_correction;
             }
 
+            // Switch hardware microsteps if prep requested it. Rescales the accumulator and increment
+            if (st_pre.mot[MOTOR_1].microstep_shift != st_run.mot[MOTOR_1].microstep_shift) {
+                _load_microstep_shift(MOTOR_1);
+            }
+
             // Detect direction change and if so:
             //    Set the direction bit in hardware.
             //    Compensate for direction change by flipping substep accumulator value about its midpoint.
@@ -500,12 +513,13 @@ static void _load_move()
 
             // Enable the stepper and start/update motor power management
             motor_1.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_1, st_pre.mot[MOTOR_1].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_1, st_pre.mot[MOTOR_1].step_sign * (1 << st_run.mot[MOTOR_1].microstep_shift));
 
         } else {  // Motor has 0 steps; might need to energize motor for power mode processing
             motor_1.motionStopped();
         }
         // accumulate counted steps to the step position and zero out counted steps for the segment currently being loaded
+        st_run.mot[MOTOR_1].microstep_phase += en.en[MOTOR_1].steps_run;
         ACCUMULATE_ENCODER(MOTOR_1);
 
 #if (MOTORS >= 2)
@@ -514,16 +528,20 @@ static void _load_move()
                 st_pre.mot[MOTOR_2].accumulator_correction_flag = false;
                 st_run.mot[MOTOR_2].substep_accumulator *= st_pre.mot[MOTOR_2].accumulator_correction;
             }
+            if (st_pre.mot[MOTOR_2].microstep_shift != st_run.mot[MOTOR_2].microstep_shift) {
+                _load_microstep_shift(MOTOR_2);
+            }
             if (st_pre.mot[MOTOR_2].direction != st_pre.mot[MOTOR_2].prev_direction) {
                 st_pre.mot[MOTOR_2].prev_direction = st_pre.mot[MOTOR_2].direction;
                 st_run.mot[MOTOR_2].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_2].substep_accumulator);
                 motor_2.setDirection(st_pre.mot[MOTOR_2].direction);
             }
             motor_2.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_2, st_pre.mot[MOTOR_2].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_2, st_pre.mot[MOTOR_2].step_sign * (1 << st_run.mot[MOTOR_2].microstep_shift));
         } else {
             motor_2.motionStopped();
         }
+        st_run.mot[MOTOR_2].microstep_phase += en.en[MOTOR_2].steps_run;
         ACCUMULATE_ENCODER(MOTOR_2);
 #endif
 #if (MOTORS >= 3)
@@ -532,16 +550,20 @@ static void _load_move()
                 st_pre.mot[MOTOR_3].accumulator_correction_flag = false;
                 st_run.mot[MOTOR_3].substep_accumulator *= st_pre.mot[MOTOR_3].accumulator_correction;
             }
+            if (st_pre.mot[MOTOR_3].microstep_shift != st_run.mot[MOTOR_3].microstep_shift) {
+                _load_microstep_shift(MOTOR_3);
+            }
             if (st_pre.mot[MOTOR_3].direction != st_pre.mot[MOTOR_3].prev_direction) {
                 st_pre.mot[MOTOR_3].prev_direction = st_pre.mot[MOTOR_3].direction;
                 st_run.mot[MOTOR_3].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_3].substep_accumulator);
                 motor_3.setDirection(st_pre.mot[MOTOR_3].direction);
             }
             motor_3.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_3, st_pre.mot[MOTOR_3].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_3, st_pre.mot[MOTOR_3].step_sign * (1 << st_run.mot[MOTOR_3].microstep_shift));
         } else {
             motor_3.motionStopped();
         }
+        st_run.mot[MOTOR_3].microstep_phase += en.en[MOTOR_3].steps_run;
         ACCUMULATE_ENCODER(MOTOR_3);
 #endif
 #if (MOTORS >= 4)
@@ -550,16 +572,20 @@ static void _load_move()
                 st_pre.mot[MOTOR_4].accumulator_correction_flag = false;
                 st_run.mot[MOTOR_4].substep_accumulator *= st_pre.mot[MOTOR_4].accumulator_correction;
             }
+            if (st_pre.mot[MOTOR_4].microstep_shift != st_run.mot[MOTOR_4].microstep_shift) {
+                _load_microstep_shift(MOTOR_4);
+            }
             if (st_pre.mot[MOTOR_4].direction != st_pre.mot[MOTOR_4].prev_direction) {
                 st_pre.mot[MOTOR_4].prev_direction = st_pre.mot[MOTOR_4].direction;
                 st_run.mot[MOTOR_4].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_4].substep_accumulator);
                 motor_4.setDirection(st_pre.mot[MOTOR_4].direction);
             }
             motor_4.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_4, st_pre.mot[MOTOR_4].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_4, st_pre.mot[MOTOR_4].step_sign * (1 << st_run.mot[MOTOR_4].microstep_shift));
         } else {
             motor_4.motionStopped();
         }
+        st_run.mot[MOTOR_4].microstep_phase += en.en[MOTOR_4].steps_run;
         ACCUMULATE_ENCODER(MOTOR_4);
 #endif
 #if (MOTORS >= 5)
@@ -568,16 +594,20 @@ static void _load_move()
                 st_pre.mot[MOTOR_5].accumulator_correction_flag = false;
                 st_run.mot[MOTOR_5].substep_accumulator *= st_pre.mot[MOTOR_5].accumulator_correction;
             }
+            if (st_pre.mot[MOTOR_5].microstep_shift != st_run.mot[MOTOR_5].microstep_shift) {
+                _load_microstep_shift(MOTOR_5);
+            }
             if (st_pre.mot[MOTOR_5].direction != st_pre.mot[MOTOR_5].prev_direction) {
                 st_pre.mot[MOTOR_5].prev_direction = st_pre.mot[MOTOR_5].direction;
                 st_run.mot[MOTOR_5].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_5].substep_accumulator);
                 motor_5.setDirection(st_pre.mot[MOTOR_5].direction);
             }
             motor_5.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_5, st_pre.mot[MOTOR_5].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_5, st_pre.mot[MOTOR_5].step_sign * (1 << st_run.mot[MOTOR_5].microstep_shift));
         } else {
             motor_5.motionStopped();
         }
+        st_run.mot[MOTOR_5].microstep_phase += en.en[MOTOR_5].steps_run;
         ACCUMULATE_ENCODER(MOTOR_5);
 #endif
 #if (MOTORS >= 6)
@@ -586,16 +616,20 @@ static void _load_move()
                 st_pre.mot[MOTOR_6].accumulator_correction_flag = false;
                 st_run.mot[MOTOR_6].substep_accumulator *= st_pre.mot[MOTOR_6].accumulator_correction;
             }
+            if (st_pre.mot[MOTOR_6].microstep_shift != st_run.mot[MOTOR_6].microstep_shift) {
+                _load_microstep_shift(MOTOR_6);
+            }
             if (st_pre.mot[MOTOR_6].direction != st_pre.mot[MOTOR_6].prev_direction) {
                 st_pre.mot[MOTOR_6].prev_direction = st_pre.mot[MOTOR_6].direction;
                 st_run.mot[MOTOR_6].substep_accumulator = -(st_run.dda_ticks_X_substeps + st_run.mot[MOTOR_6].substep_accumulator);
                 motor_6.setDirection(st_pre.mot[MOTOR_6].direction);
             }
             motor_6.enable();
-            SET_ENCODER_STEP_SIGN(MOTOR_6, st_pre.mot[MOTOR_6].step_sign);
+            SET_ENCODER_STEP_SIGN(MOTOR_6, st_pre.mot[MOTOR_6].step_sign * (1 << st_run.mot[MOTOR_6].microstep_shift));
         } else {
             motor_6.motionStopped();
         }
+        st_run.mot[MOTOR_6].microstep_phase += en.en[MOTOR_6].steps_run;
         ACCUMULATE_ENCODER(MOTOR_6);
 #endif
 
@@ -606,6 +640,9 @@ static void _load_move()
     // handle dwells and commands
     } else if (st_pre.block_type == BLOCK_TYPE_DWELL) {
         st_run.dwell_ticks_downcount = st_pre.dwell_ticks;
+        if (st_run.motion_phase != MOTION_PHASE_CRUISE) {
+            _load_motion_phase(MOTION_PHASE_CRUISE);
+        }
         SysTickTimer.registerEvent(&dwell_systick_event); // We now use SysTick events to handle dwells
 
     // handle synchronous commands
@@ -620,6 +657,85 @@ static void _load_move()
     st_request_exec_move();                             // exec and prep next move
 }
 
+/****************************************************************************************
+ * _load_microstep_shift() - switch a motor's hardware microsteps during a load
+ *
+ *  Called from _load_move() once the segment's DDA depth is loaded and the accumulator
+ *  has been corrected for the segment time. Switching coarser waits until the motor is
+ *  on a step of the coarser setting - a full step when rapid microsteps is 1. Switching
+ *  anywhere else would make the driver round its position to the coarser grid and the
+ *  difference would be lost. Switching finer can always be done. If the switch is not
+ *  made the motor keeps its current setting and increment and prep asks again on the
+ *  next segment.
+ *
+ *  The accumulator holds the progress toward the next pulse and is rescaled to the new
+ *  pulse size. Going finer can leave whole fine steps owed; these are added to the
+ *  segment's increment, or the switch is deferred if the segment has no room for them.
+ */
+
+static void _load_microstep_shift(const uint8_t motor)
+{
+    stRunMotor_t *run = &st_run.mot[motor];
+    stPrepMotor_t *pre = &st_pre.mot[motor];
+
+    int32_t phase = run->microstep_phase + en.en[motor].steps_run;
+    if ((pre->microstep_shift > run->microstep_shift) &&
+        ((phase & ((1 << pre->microstep_shift) - 1)) != 0)) {
+        return;                                                 // not on a step of the coarser setting
+    }
+    int64_t depth = st_run.dda_ticks_X_substeps;
+    int64_t progress = (int64_t)run->substep_accumulator + depth; // substeps toward the next pulse
+    uint64_t increment = pre->substep_increment_shifted;
+
+    if (pre->microstep_shift > run->microstep_shift) {          // coarser pulses
+        progress >>= (pre->microstep_shift - run->microstep_shift);
+    } else {                                                    // finer pulses
+        uint32_t owed = 0;                                      // shift-and-subtract - no divide in the ISR
+        for (uint8_t i = run->microstep_shift - pre->microstep_shift; i > 0; i--) {
+            progress <<= 1;
+            owed <<= 1;
+            if (progress >= depth) {
+                progress -= depth;
+                owed++;
+            }
+        }
+        increment += (uint64_t)owed * (uint32_t)DDA_SUBSTEPS;
+        if (increment > (uint64_t)depth) {
+            return;                                             // no room to pay the owed steps
+        }
+    }
+    run->substep_accumulator = (int32_t)(progress - depth);
+    run->substep_increment = (uint32_t)increment;
+    run->microstep_shift = pre->microstep_shift;
+    Motors[motor]->setMicrosteps(st_cfg.mot[motor].microsteps >> run->microstep_shift);
+}
+
+/****************************************************************************************
+ * _load_motion_phase() - apply the run current for the motion phase being loaded
+ *
+ *  Motors with a cruise power level set run at it in the body of a move and in dwells,
+ *  and at their power level in heads and tails so the ramps get full torque. This is
+ *  only called when the phase changes, so drivers see one update per section.
+ *
+ *  Drivers may take a while to apply the change (TMC2130: next SysTick plus the SPI
+ *  transfer), so full current is raised from st_prep_line() when a head or tail segment
+ *  is prepped - one segment ahead of the load. Only the drop to cruise current waits for
+ *  the loader.
+ */
+
+static void _load_motion_phase(const stMotionPhase motion_phase)
+{
+    st_run.motion_phase = motion_phase;
+    for (uint8_t motor=0; motor<MOTORS; motor++) {
+        if (fp_ZERO(st_cfg.mot[motor].power_level_cruise)) {
+            continue;
+        }
+        Motors[motor]->setMotionPowerLevel((motion_phase == MOTION_PHASE_CRUISE) ?
+                                           st_cfg.mot[motor].power_level_cruise_scaled :
+                                           st_cfg.mot[motor].power_level_scaled);
+    }
+}
+
 /***********************************************************************************
  * st_prep_line() - Prepare the next move for the loader
  *
@@ -639,12 +755,14 @@ static void _load_move()
  *    - segment_time - how many minutes the segment should run. If timing is not
  *      100% accurate this will affect the move velocity, but not the distance traveled.
  *
+ *    - motion_phase - ramp (head or tail) or cruise (body). Used to scale run current.
+ *
  * NOTE:  Many of the expressions are sensitive to casting and execution order to avoid long-term
  *        accuracy errors due to floating point round off. One earlier failed attempt was:
  *          dda_ticks_X_substeps = (int32_t)((microseconds/1000000) * f_dda * dda_substeps);
  */
 
-stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time)
+stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time, stMotionPhase motion_phase)
 {
     // trap assertion failures and other conditions that would prevent queuing the line
     if (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_EXEC) {     // never supposed to happen
@@ -660,6 +778,10 @@ stat_t st_prep_line(float travel_steps[], float following_error[], float segment
 
     st_pre.dda_ticks = (int32_t)(segment_time * 60 * FREQUENCY_DDA);  // NB: converts minutes to seconds
     st_pre.dda_ticks_X_substeps = st_pre.dda_ticks * DDA_SUBSTEPS;
+    st_pre.motion_phase = motion_phase;
+    if ((motion_phase == MOTION_PHASE_RAMP) && (st_run.motion_phase != MOTION_PHASE_RAMP)) {
+        _load_motion_phase(MOTION_PHASE_RAMP);              // raise current while the segment before runs
+    }
 
     // setup motor parameters
 
@@ -718,7 +840,27 @@ stat_t st_prep_line(float travel_steps[], float following_error[], float segment
         // Rounding is performed to eliminate a negative bias in the uint32 conversion
         // that results in long-term negative drift. (fabs/round order doesn't matter)
 
-        st_pre.mot[motor].substep_increment = round(fabs(travel_steps[motor] * DDA_SUBSTEPS));
+        float substeps = fabs(travel_steps[motor] * DDA_SUBSTEPS);
+        uint8_t shift = st_run.mot[motor].microstep_shift;  // stable: the loader has finished with st_pre
+        st_pre.mot[motor].substep_increment = round(substeps / (1 << shift));
+
+        // Adaptive microstepping. Request rapid microsteps at high step rates and configured
+        // microsteps at low rates. The loader applies the request on a full-step boundary,
+        // so the increment is also computed for the requested setting (see _load_microstep_shift())
+        // Switches are not requested on direction changes; those happen at low rates anyway.
+
+        st_pre.mot[motor].microstep_shift = shift;
+        if ((st_cfg.mot[motor].microstep_shift_max != 0) &&
+            (st_pre.mot[motor].direction == st_pre.mot[motor].prev_direction)) {
+
+            float step_rate = fabs(travel_steps[motor]) / (segment_time * 60 * FREQUENCY_DDA); // steps per tick
+            if (step_rate > MICROSTEP_UPSHIFT_RATE) {
+                st_pre.mot[motor].microstep_shift = st_cfg.mot[motor].microstep_shift_max;
+            } else if (step_rate < MICROSTEP_DOWNSHIFT_RATE) {
+                st_pre.mot[motor].microstep_shift = 0;
+            }
+        }
+        st_pre.mot[motor].substep_increment_shifted = round(substeps / (1 << st_pre.mot[motor].microstep_shift));
     }
     st_pre.block_type = BLOCK_TYPE_ALINE;
     st_pre.buffer_state = PREP_BUFFER_OWNED_BY_LOADER;    // signal that prep buffer is ready
@@ -775,15 +917,74 @@ void st_prep_out_of_band_dwell(float microseconds)
     }    
 }
 
+/*
+ * st_end_dwell() - cut short a dwell the planner is polling with
+ *
+ * Used by the input waits to release a polling dwell as soon as the input they are
+ * waiting on changes. A prepped dwell is turned into a null block so the exec is
+ * re-run as soon as the loader reaches it. If end_running is set the running dwell
+ * also ends at the next SysTick - the caller must know the running dwell is its own.
+ * Safe to call from interrupts; neither write can lengthen a dwell.
+ */
+
+void st_end_dwell(bool end_running)
+{
+    if ((st_pre.buffer_state == PREP_BUFFER_OWNED_BY_LOADER) && (st_pre.block_type == BLOCK_TYPE_DWELL)) {
+        st_pre.block_type = BLOCK_TYPE_NULL;
+    }
+    if (end_running && (st_run.dwell_ticks_downcount > 1)) {
+        st_run.dwell_ticks_downcount = 1;
+    }
+}
+
 /*
  * _set_hw_microsteps() - set microsteps in hardware
+ *
+ *  Also drops any rapid microstep shift. The accumulator is rescaled from the coarse pulse
+ *  to a configured microstep; whole steps this leaves owed can't be issued here and show up
+ *  as following error. The phase restarts at zero, so the current position is taken as a
+ *  full step - it can't be read back from the driver. Only called from configuration, when
+ *  the motor is not running.
  */
 
 static void _set_hw_microsteps(const uint8_t motor, const uint8_t microsteps)
 {
     if (motor >= MOTORS) { return; }
 
+    stRunMotor_t *run = &st_run.mot[motor];
+    int64_t depth = st_run.dda_ticks_X_substeps;
+    if ((run->microstep_shift != 0) && (depth != 0)) {
+        int64_t progress = ((int64_t)run->substep_accumulator + depth) << run->microstep_shift;
+        run->substep_accumulator = (int32_t)((progress % depth) - depth);
+    }
     Motors[motor]->setMicrosteps(microsteps);
+    run->microstep_shift = 0;                       // hardware is back at configured microsteps
+    run->microstep_phase = 0;
+}
+
+/*
+ * _set_motor_microstep_shift() - set the rapid microstep shift from microsteps and rapid microsteps
+ *
+ *  Rapid microsteps must divide the configured microsteps by a power of 2, and the driver
+ *  must be able to switch microsteps at once, otherwise adaptive microstepping is disabled
+ *  for the motor.
+ */
+
+static void _set_motor_microstep_shift(const uint8_t motor)
+{
+    cfgMotor_t *mot = &st_cfg.mot[motor];
+    mot->microstep_shift_max = 0;
+    if ((mot->microsteps_rapid == 0) || (mot->microsteps_rapid >= mot->microsteps) ||
+        !Motors[motor]->canSwitchMicrosteps()) {
+        return;
+    }
+    uint8_t ratio = mot->microsteps / mot->microsteps_rapid;
+    if (((ratio * mot->microsteps_rapid) != mot->microsteps) || ((ratio & (ratio-1)) != 0)) {
+        return;
+    }
+    while (ratio >>= 1) {
+        mot->microstep_shift_max++;
+    }
 }
 
 /***********************************************************************************
@@ -803,7 +1004,7 @@ static int8_t _motor(const index_t index)
 
 /*
  * _set_motor_steps_per_unit() - what it says
- * This function will need to be rethought if microstep morphing is implemented
+ * Always in configured microsteps, also while adaptive microstepping has a motor running coarse
  */
 
 static float _set_motor_steps_per_unit(nvObj_t *nv)
@@ -826,10 +1027,13 @@ static float _set_motor_steps_per_unit(nvObj_t *nv)
  * st_set_tr() - set travel per motor revolution
  * st_get_mi() - get motor microsteps
  * st_set_mi() - set motor microsteps
+ * st_get_mr() - get motor rapid microsteps
+ * st_set_mr() - set motor rapid microsteps
  * 
  * st_set_pm() - set motor power mode
  * st_get_pm() - get motor power mode
  * st_set_pl() - set motor power level
+ * st_set_pc() - set motor cruise power level
  */
 
 /*
@@ -912,6 +1116,24 @@ stat_t st_set_mi(nvObj_t *nv)
     ritorno(set_integer(nv, st_cfg.mot[_motor(nv->index)].microsteps, 1, 255));
     _set_motor_steps_per_unit(nv);
     _set_hw_microsteps(_motor(nv->index), nv->value_int);
+    _set_motor_microstep_shift(_motor(nv->index));
+    return (STAT_OK);
+}
+
+// rapid microsteps (adaptive microstepping)
+stat_t st_get_mr(nvObj_t *nv) { return(get_integer(nv, st_cfg.mot[_motor(nv->index)].microsteps_rapid)); }
+stat_t st_set_mr(nvObj_t *nv)
+{
+    uint8_t motor = _motor(nv->index);
+    if ((nv->value_int != 0) && !Motors[motor]->canSwitchMicrosteps()) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);  // driver can't change microsteps between segments
+    }
+    ritorno(set_integer(nv, st_cfg.mot[motor].microsteps_rapid, 0, 255));
+    _set_motor_microstep_shift(motor);
+    if ((st_cfg.mot[motor].microsteps_rapid != 0) && (st_cfg.mot[motor].microstep_shift_max == 0)) {
+        nv_add_conditional_message((const char *)"*** WARNING *** Rapid microsteps must be microsteps divided by a power of 2. Disabled");
+    }
+    _set_hw_microsteps(motor, st_cfg.mot[motor].microsteps);
     return (STAT_OK);
 }
 
@@ -987,6 +1209,23 @@ stat_t st_set_pl(nvObj_t *nv)
     return(STAT_OK);
 }
 
+/*
+ * st_get_pc() - get motor cruise power level
+ * st_set_pc() - set motor cruise power level
+ *
+ *  Run current used in the body of a move and in dwells. Heads and tails run at the
+ *  power level. Zero disables the feature and the power level is used throughout.
+ *  Only takes effect on drivers that implement setMotionPowerLevel() (e.g. TMC2130).
+ */
+stat_t st_get_pc(nvObj_t *nv) { return(get_float(nv, st_cfg.mot[_motor(nv->index)].power_level_cruise)); }
+stat_t st_set_pc(nvObj_t *nv)
+{
+    uint8_t m = _motor(nv->index);
+    ritorno(set_float_range(nv, st_cfg.mot[m].power_level_cruise, 0.0, 1.0));
+    st_cfg.mot[m].power_level_cruise_scaled = (nv->value_flt * POWER_LEVEL_SCALE_FACTOR);
+    return(STAT_OK);
+}
+
 /*
  * st_get_pwr()	- get current motor power
  *
@@ -1135,12 +1374,14 @@ static const char fmt_0ma[] = "[%s%s] m%s map to axis%15d [0=X,1=Y,2=Z...]\n";
 static const char fmt_0sa[] = "[%s%s] m%s step angle%20.3f%s\n";
 static const char fmt_0tr[] = "[%s%s] m%s travel per revolution%10.4f%s\n";
 static const char fmt_0mi[] = "[%s%s] m%s microsteps%16d [1,2,4,8,16,32]\n";
+static const char fmt_0mr[] = "[%s%s] m%s rapid microsteps%10d [0=disabled,1,2,4,8,16]\n";
 static const char fmt_0su[] = "[%s%s] m%s steps per unit %17.5f steps per%s\n";
 static const char fmt_0po[] = "[%s%s] m%s polarity%18d [0=normal,1=reverse]\n";
 static const char fmt_0ep[] = "[%s%s] m%s enable polarity%11d [0=active HIGH,1=active LOW]\n";
 static const char fmt_0sp[] = "[%s%s] m%s step polarity%13d [0=active HIGH,1=active LOW]\n";
 static const char fmt_0pm[] = "[%s%s] m%s power management%10d [0=disabled,1=always on,2=in cycle,3=when moving]\n";
 static const char fmt_0pl[] = "[%s%s] m%s motor power level%13.3f [0.000=minimum, 1.000=maximum]\n";
+static const char fmt_0pc[] = "[%s%s] m%s cruise power level%12.3f [0.000=use power level, 1.000=maximum]\n";
 static const char fmt_pwr[] = "[%s%s] Motor %c power level:%12.3f\n";
 
 void st_print_me(nvObj_t *nv) { text_print(nv, fmt_me);}    // TYPE_NULL - message only
@@ -1175,12 +1416,14 @@ void st_print_ma(nvObj_t *nv) { _print_motor_int(nv, fmt_0ma);}
 void st_print_sa(nvObj_t *nv) { _print_motor_flt_units(nv, fmt_0sa, DEGREE_INDEX);}
 void st_print_tr(nvObj_t *nv) { _print_motor_flt_units(nv, fmt_0tr, cm_get_units_mode(MODEL));}
 void st_print_mi(nvObj_t *nv) { _print_motor_int(nv, fmt_0mi);}
+void st_print_mr(nvObj_t *nv) { _print_motor_int(nv, fmt_0mr);}
 void st_print_su(nvObj_t *nv) { _print_motor_flt_units(nv, fmt_0su, cm_get_units_mode(MODEL));}
 void st_print_po(nvObj_t *nv) { _print_motor_int(nv, fmt_0po);}
 void st_print_ep(nvObj_t *nv) { _print_motor_int(nv, fmt_0ep);}
 void st_print_sp(nvObj_t *nv) { _print_motor_int(nv, fmt_0sp);}
 void st_print_pm(nvObj_t *nv) { _print_motor_int(nv, fmt_0pm);}
 void st_print_pl(nvObj_t *nv) { _print_motor_flt(nv, fmt_0pl);}
+void st_print_pc(nvObj_t *nv) { _print_motor_flt(nv, fmt_0pc);}
 void st_print_pwr(nvObj_t *nv){ _print_motor_pwr(nv, fmt_pwr);}
 
 #endif // __TEXT_MODE
@@ -57,9 +57,22 @@
  *    If we were running from batteries or otherwise cared about the energy budget we
  *    might not be so cavalier about this.
  *
- *    On most ARM implementation the DDA clock runs at 400 KHz, but it's bi-phasic so the effective
- *    step rate is 200 KHz. This leaves 2.5 uSec between pulse timer (DDA) interrupts.
- *    This consumes roughly 15 - 20% of the 84 MHz CPU clock for pulsing 6 motors.
+ *  - One interrupt per DDA tick: the DDA timer interrupts once per tick (FREQUENCY_DDA,
+ *    150 KHz on the SAM3X boards). Each interrupt first ends the pulses raised on the
+ *    previous tick, then runs the DDAs and raises the pulses for this tick. There is no
+ *    separate pulse-off interrupt, so a step pulse is high for one full DDA period
+ *    (6.67 uSec at 150 KHz), minus the few cycles between the pin set and the next
+ *    interrupt's clear.
+ *
+ *    Budget: at 84 MHz a 150 KHz tick is 560 CPU cycles. The ISR for 6 motors runs in
+ *    roughly 80 - 120 cycles, or about 15 - 20% of the CPU. Doubling FREQUENCY_DDA to
+ *    300 KHz (280 cycles) is the practical ceiling on the SAM3X, as the segment load
+ *    (_load_move()) also has to fit in one tick. The 300 MHz SAMS70 runs at 300 KHz.
+ *
+ *    The maximum step rate of a motor equals FREQUENCY_DDA. At that rate the low time
+ *    between pulses is only the gap between stepEnd() and stepStart() in the same
+ *    interrupt, so drivers with a minimum low time (e.g. 1.9 uSec for the DRV8825)
+ *    should be run at no more than half the DDA rate.
  *
  *  - Pulse timing is also helped by minimizing the time spent loading the next move
  *    segment. The time budget for the load is less than the time remaining before the
@@ -283,6 +296,11 @@ typedef enum {
 } stPowerMode;
 #define MOTOR_POWER_MODE_MAX_VALUE    MOTOR_POWERED_ONLY_WHEN_MOVING
 
+typedef enum {                          // motion phase of the loaded segment, used to scale run current
+    MOTION_PHASE_RAMP = 0,              // head or tail - accelerating or decelerating, full current
+    MOTION_PHASE_CRUISE                 // body or dwell - cruise current, if set
+} stMotionPhase;
+
 // Stepper power management settings
 #define Vcc         3.3                 // volts
 #define MaxVref    2.25                 // max vref for driver circuit. Our ckt is 2.25 volts
@@ -331,6 +349,22 @@ typedef enum {
 #define STEP_CORRECTION_MAX         (float)0.60     // max step correction allowed in a single segment
 #define STEP_CORRECTION_HOLDOFF            5        // minimum number of segments to wait between error correction
 
+/* Adaptive microstepping settings
+ *
+ *  A motor with rapid microsteps configured ({1mr:...}) is switched to that coarser setting when its
+ *  step rate approaches the DDA ceiling, and back to its configured microsteps as it slows down.
+ *  Rates are expressed as configured microsteps per DDA tick. The upshift and downshift rates are
+ *  apart to provide hysteresis. Switching coarser waits for a step boundary of the coarser setting
+ *  (a full step when rapid microsteps is 1) and is never forced, as a switch between steps would
+ *  lose position. Only drivers whose microstep change takes effect at once (pin-selected microstep
+ *  lines) accept rapid microsteps - see canSwitchMicrosteps().
+ *
+ *  The planner, kinematics and encoders always work in configured microsteps. While a motor runs
+ *  coarse each pulse is counted as 2^shift steps, so position is never rescaled.
+ */
+#define MICROSTEP_UPSHIFT_RATE      (float)0.50     // switch to rapid microsteps above this step rate
+#define MICROSTEP_DOWNSHIFT_RATE    (float)0.25     // switch back to configured microsteps below this rate
+
 /*
  * Stepper control structures
  *
@@ -354,8 +388,10 @@ typedef struct cfgMotor {                   // per-motor configs
     // public
     uint8_t motor_map;                      // map motor to axis
     uint8_t microsteps;                     // microsteps to apply for each axis (ex: 8)
+    uint8_t microsteps_rapid;               // coarser microsteps used at high step rates (0 = disabled)
     uint8_t polarity;                       // 0=normal polarity, 1=reverse motor direction
     float power_level;                      // set 0.000 to 1.000 for PMW vref setting
+    float power_level_cruise;               // set 0.000 to 1.000 for body and dwell current (0 = use power_level)
     float step_angle;                       // degrees per whole step (ex: 1.8)
     float travel_rev;                       // mm or deg of travel per motor revolution
     float steps_per_unit;                   // microsteps per mm (or degree) of travel
@@ -363,6 +399,8 @@ typedef struct cfgMotor {                   // per-motor configs
 
     // private
     float power_level_scaled;               // scaled to internal range - must be between 0 and 1
+    float power_level_cruise_scaled;        // scaled cruise power level
+    uint8_t microstep_shift_max;            // log2(microsteps / microsteps_rapid), 0 if disabled
 } cfgMotor_t;
 
 typedef struct stConfig {                   // stepper configs
@@ -378,6 +416,8 @@ typedef struct stRunMotor {                 // one per controlled motor
     bool motor_flag;                        // true if motor is participating in this move
     uint32_t power_systick;                 // sys_tick for next motor power state transition
     float power_level_dynamic;              // power level for this segment of idle
+    uint8_t microstep_shift;                // microsteps in hardware are configured microsteps >> shift
+    int32_t microstep_phase;                // position in configured microsteps, used to find full steps
 } stRunMotor_t;
 
 typedef struct stRunSingleton {             // Stepper static values and axis parameters
@@ -385,6 +425,7 @@ typedef struct stRunSingleton {             // Stepper static values and axis pa
     uint32_t dda_ticks_downcount;           // dda tick down-counter (unscaled)
     uint32_t dwell_ticks_downcount;         // dwell tick down-counter (unscaled)
     uint32_t dda_ticks_X_substeps;          // ticks multiplied by scaling factor
+    stMotionPhase motion_phase;             // motion phase currently applied to motor current
     stRunMotor_t mot[MOTORS];               // runtime motor structures
     magic_t magic_end;
 } stRunSingleton_t;
@@ -394,6 +435,7 @@ typedef struct stRunSingleton {             // Stepper static values and axis pa
 
 typedef struct stPrepMotor {
     uint32_t substep_increment;             // total steps in axis times substep factor
+    uint32_t substep_increment_shifted;     // substep increment at the requested microstep shift
     bool motor_flag;                        // true if motor is participating in this move
 
     // direction and direction change
@@ -409,6 +451,9 @@ typedef struct stPrepMotor {
     float prev_segment_time;                // segment time from previous segment run for this motor
     float accumulator_correction;           // factor for adjusting accumulator between segments
     uint8_t accumulator_correction_flag;    // signals accumulator needs correction
+
+    // adaptive microstepping
+    uint8_t microstep_shift;                // microstep shift requested for this segment
 } stPrepMotor_t;
 
 typedef struct stPrepSingleton {
@@ -420,6 +465,7 @@ typedef struct stPrepSingleton {
     uint32_t dda_ticks;                     // DDA ticks for the move
     uint32_t dwell_ticks;                   // dwell ticks remaining
     uint32_t dda_ticks_X_substeps;          // DDA ticks scaled by substep factor
+    stMotionPhase motion_phase;             // motion phase of the prepped segment
     stPrepMotor_t mot[MOTORS];              // prep time motor structs
     magic_t magic_end;
 } stPrepSingleton_t;
@@ -573,6 +619,16 @@ public:
     virtual void setDirection(uint8_t new_direction) { /* must override */ };
     virtual void setMicrosteps(const uint8_t microsteps) { /* must override */ };
     virtual void setPowerLevel(float new_pl) { /* must override */ };
+
+    // True if setMicrosteps() takes effect before the next step pulse, so the loader can
+    // switch microsteps between segments (adaptive microstepping). Drivers that change
+    // microsteps over SPI or not at all leave this false.
+    virtual bool canSwitchMicrosteps() { return false; };
+
+    // Change the run current for the motion phase. Called from the loader at segment
+    // boundaries (DDA ISR level) so it must not block. Drivers that can't change current
+    // on the fly ignore it.
+    virtual void setMotionPowerLevel(float new_pl) {};
 };
 
 
@@ -595,7 +651,8 @@ void st_prep_null(void);
 void st_prep_command(void *bf);        // use a void pointer since we don't know about mpBuf_t yet)
 void st_prep_dwell(float microseconds);
 void st_prep_out_of_band_dwell(float microseconds);
-stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time);
+void st_end_dwell(bool end_running);
+stat_t st_prep_line(float travel_steps[], float following_error[], float segment_time, stMotionPhase motion_phase);
 
 stat_t st_get_ma(nvObj_t *nv);
 stat_t st_set_ma(nvObj_t *nv);
@@ -605,6 +662,8 @@ stat_t st_get_tr(nvObj_t *nv);
 stat_t st_set_tr(nvObj_t *nv);
 stat_t st_get_mi(nvObj_t *nv);
 stat_t st_set_mi(nvObj_t *nv);
+stat_t st_get_mr(nvObj_t *nv);
+stat_t st_set_mr(nvObj_t *nv);
 stat_t st_get_su(nvObj_t *nv);
 stat_t st_set_su(nvObj_t *nv);
 
@@ -619,6 +678,8 @@ stat_t st_get_pm(nvObj_t *nv);
 stat_t st_set_pm(nvObj_t *nv);
 stat_t st_get_pl(nvObj_t *nv);
 stat_t st_set_pl(nvObj_t *nv);
+stat_t st_get_pc(nvObj_t *nv);
+stat_t st_set_pc(nvObj_t *nv);
 
 stat_t st_get_pwr(nvObj_t *nv);
 
@@ -634,12 +695,14 @@ stat_t st_get_dw(nvObj_t *nv);
     void st_print_sa(nvObj_t *nv);
     void st_print_tr(nvObj_t *nv);
     void st_print_mi(nvObj_t *nv);
+    void st_print_mr(nvObj_t *nv);
     void st_print_su(nvObj_t *nv);
     void st_print_po(nvObj_t *nv);
     void st_print_ep(nvObj_t *nv);
     void st_print_sp(nvObj_t *nv);
     void st_print_pm(nvObj_t *nv);
     void st_print_pl(nvObj_t *nv);
+    void st_print_pc(nvObj_t *nv);
     void st_print_pwr(nvObj_t *nv);
     void st_print_mt(nvObj_t *nv);
     void st_print_me(nvObj_t *nv);
@@ -651,12 +714,14 @@ stat_t st_get_dw(nvObj_t *nv);
     #define st_print_sa tx_print_stub
     #define st_print_tr tx_print_stub
     #define st_print_mi tx_print_stub
+    #define st_print_mr tx_print_stub
     #define st_print_su tx_print_stub
     #define st_print_po tx_print_stub
     #define st_print_ep tx_print_stub
     #define st_print_sp tx_print_stub
     #define st_print_pm tx_print_stub
     #define st_print_pl tx_print_stub
+    #define st_print_pc tx_print_stub
     #define st_print_pwr tx_print_stub
     #define st_print_mt tx_print_stub
     #define st_print_me tx_print_stub
@@ -83,6 +83,10 @@ stat_t text_parser(char *str)
     // parse and execute the command (only processes 1 command per line)
     ritorno(_text_parser_kernal(str, nv));      // run the parser to decode the command
     if ((nv->valuetype == TYPE_NULL) || (nv->valuetype == TYPE_PARENT)) {
+        if ((js.json_mode == TEXT_MODE) && nv_index_is_group(nv->index)) {
+            nv_display_group(nv->token);        // stream the group display - see nv_group_display_callback()
+            return (STAT_OK);
+        }
         if (nv_get(nv) == STAT_COMPLETE) {      // populate value, group values, or run uber-group displays
             return (STAT_OK);                   // return for uber-group displays so they don't print twice
         }
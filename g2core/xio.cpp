@@ -163,10 +163,15 @@ struct xioDeviceWrapperBase {                // C++ base class for device primit
     virtual void flush() {};
     virtual void flushRead() {};       // This should call _flushLine() before flushing the device.
     virtual bool flushToCommand() { return false; };
-    virtual int16_t write(const char *buffer, int16_t len) { return -1; };
+    virtual int16_t write(const char *buffer, int16_t len, xioTxPriority priority) { return -1; };
+    virtual void drainTX() {};
+    virtual bool isTXBackedUp() { return false; };
+    virtual uint16_t txRoom() { return XIO_TX_PENDING_SIZE; };
 
     virtual char *readline(devflags_t limit_flags, uint16_t &size) { return nullptr; };
 
+    virtual uint16_t linesQueued() { return 0; };
+    virtual uint16_t lineSlots() { return 0; };
 #if MARLIN_COMPAT_ENABLED == true
     virtual void exitFakeBootloaderMode() {};
 #endif
@@ -252,10 +257,11 @@ struct xio_t {
      * 1) If a device fails to write the data, or all the data, then it's ignored
      * 2) Only the amount written by the *last* device to match (CTRL|ACTIVE) is returned.
      *
-     * In the current environment, these are not foreseen to cause trouble since these
-     * are blocking writes and we expect to only really be writing to one device.
+     * In the current environment, these are not foreseen to cause trouble since we expect
+     * to only really be writing to one device. Writes do not block: whatever the device
+     * can't take is queued by the device wrapper and drained by xio_tx_callback().
      */
-    size_t write(const char *buffer, size_t size, bool only_to_muted)
+    size_t write(const char *buffer, size_t size, bool only_to_muted, xioTxPriority priority)
     {
         size_t total_written = -1;
         for (int8_t i = 0; i < _dev_count; ++i) {
@@ -266,12 +272,8 @@ struct xio_t {
                 ok_channel = DeviceWrappers[i]->isMuted();
             }
             if (ok_channel) {
-                const char *buf = buffer;
-                int16_t to_write = size;
-                while (to_write > 0) {
-                    size_t written = DeviceWrappers[i]->write(buf, to_write);
-                    buf += written;
-                    to_write -= written;
+                int16_t written = DeviceWrappers[i]->write(buffer, size, priority);
+                if (written > 0) {
                     total_written += written;
                 }
             }
@@ -285,12 +287,44 @@ struct xio_t {
      * The input buffer must be NUL terminated
      */
 
-    int16_t writeline(const char *buffer, bool only_to_muted)
+    int16_t writeline(const char *buffer, bool only_to_muted, xioTxPriority priority)
     {
         int16_t len = strlen(buffer);
-        return write(buffer, len, only_to_muted);
+        return write(buffer, len, only_to_muted, priority);
     };
 
+    /*
+     * drainTX()       - move queued output to the devices as they can take it
+     * txBackedUp()    - true if any control channel has output queued
+     * txHasHeadroom() - true if every control channel has room for a full response
+     */
+    void drainTX()
+    {
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            DeviceWrappers[i]->drainTX();
+        }
+    }
+
+    bool txBackedUp()
+    {
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            if (DeviceWrappers[i]->isCtrlAndActive() && DeviceWrappers[i]->isTXBackedUp()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool txHasHeadroom()
+    {
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            if (DeviceWrappers[i]->isCtrlAndActive() && (DeviceWrappers[i]->txRoom() < XIO_TX_HEADROOM)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     /*
      * flush() - flush all readable devices' write buffers
      */
@@ -398,6 +432,32 @@ struct xio_t {
     };
 #endif
 
+    /*
+     * linesQueued() - count complete lines received on active devices but not yet read
+     */
+    uint16_t linesQueued() {
+        uint16_t lines = 0;
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            if (DeviceWrappers[i]->isActive()) {
+                lines += DeviceWrappers[i]->linesQueued();
+            }
+        }
+        return lines;
+    };
+
+    /*
+     * lineSlots() - count full-length lines the RX buffers of active devices can hold
+     */
+    uint16_t lineSlots() {
+        uint16_t slots = 0;
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            if (DeviceWrappers[i]->isActive()) {
+                slots += DeviceWrappers[i]->lineSlots();
+            }
+        }
+        return slots;
+    };
+
     uint16_t magic_end;
 };
 
@@ -476,6 +536,14 @@ struct LineRXBuffer : RXBuffer<_size, owner_type, char> {
     }
 #endif
 
+    uint16_t linesQueued() {
+        return _lines_found;
+    }
+
+    uint16_t lineSlots() {
+        return _size / MARLIN_RX_LINE_LENGTH;
+    }
+
     LineRXBuffer(owner_type owner) : parent_type{owner} {};
 
     void init() {
@@ -1024,7 +1092,11 @@ struct xioDeviceWrapper : xioDeviceWrapperBase {    // describes a device for re
     LineRXBuffer<1024, Device> _rx_buffer;
     TXBuffer<1024, Device> _tx_buffer;
 
-    xioDeviceWrapper(Device dev, uint8_t _caps) : xioDeviceWrapperBase(_caps), _dev{dev}, _rx_buffer{_dev}, _tx_buffer{_dev}
+    // output the device could not take yet, in order - see write()
+    char _tx_pending[XIO_TX_PENDING_SIZE];
+    uint16_t _tx_pending_len;
+
+    xioDeviceWrapper(Device dev, uint8_t _caps) : xioDeviceWrapperBase(_caps), _dev{dev}, _rx_buffer{_dev}, _tx_buffer{_dev}, _tx_pending_len{0}
     {
 //        _dev->setDataAvailableCallback([&](const size_t &length) {
 //
@@ -1041,6 +1113,7 @@ struct xioDeviceWrapper : xioDeviceWrapperBase {    // describes a device for re
     };
 
     void flush() final {
+        _tx_pending_len = 0;
         _tx_buffer.flush();
         return _dev->flush();
     }
@@ -1060,13 +1133,80 @@ struct xioDeviceWrapper : xioDeviceWrapperBase {    // describes a device for re
         return _rx_buffer.flushToCommand();
     }
 
-    virtual int16_t write(const char *buffer, int16_t len) final {
+    /*
+     * write() - write to the device without waiting on the host
+     *
+     *  Output goes straight to the device TX buffer when nothing is queued ahead of it.
+     *  Whatever the device can't take is queued in _tx_pending and drained from the main
+     *  loop by drainTX(), so lines stay in order. Reports (XIO_TX_REPORT) that haven't
+     *  started are dropped instead of being queued behind a backlog - the report callbacks
+     *  also hold off while output is queued, so the next report carries the latest values.
+     *
+     *  The controller stops reading commands while there is less than XIO_TX_HEADROOM free,
+     *  so a response normally fits. Only a single burst larger than the free space waits for
+     *  the device, as all writes used to.
+     */
+    virtual int16_t write(const char *buffer, int16_t len, xioTxPriority priority) final {
         if (!isConnected()) {
             return -1;
         }
-        return _tx_buffer.write(buffer, len);
+        drainTX();
+        int16_t total = len;
+        if (_tx_pending_len == 0) {                     // nothing queued ahead - go straight to the device
+            _writeDirect(buffer, len);
+        } else if (priority == XIO_TX_REPORT) {
+            return 0;
+        }
+        if (len == 0) {
+            return total;
+        }
+        if (len > txRoom()) {
+            if ((priority == XIO_TX_REPORT) && (len == total)) {
+                return 0;                               // none of it was sent, so drop it whole
+            }
+            while (len > txRoom()) {                    // last resort: wait for the device
+                if (!isConnected()) {
+                    return -1;
+                }
+                if (_tx_pending_len == 0) {
+                    _writeDirect(buffer, len);
+                } else {
+                    drainTX();
+                }
+            }
+        }
+        memcpy(&_tx_pending[_tx_pending_len], buffer, len);
+        _tx_pending_len += len;
+        return total;
+    }
+
+    void _writeDirect(const char *&buffer, int16_t &len) {
+        int16_t written = _tx_buffer.write(buffer, len);
+        if (written > 0) {
+            buffer += written;
+            len -= written;
+        }
     }
 
+    void drainTX() final {
+        if (_tx_pending_len == 0) {
+            return;
+        }
+        if (!isConnected()) {                           // nobody to send it to
+            _tx_pending_len = 0;
+            return;
+        }
+        int16_t written = _tx_buffer.write(_tx_pending, _tx_pending_len);
+        if (written <= 0) {
+            return;
+        }
+        _tx_pending_len -= written;
+        memmove(_tx_pending, &_tx_pending[written], _tx_pending_len);
+    }
+
+    bool isTXBackedUp() final { return (_tx_pending_len > 0); }
+    uint16_t txRoom() final { return (XIO_TX_PENDING_SIZE - _tx_pending_len); }
+
     virtual char *readline(devflags_t limit_flags, uint16_t &size) final {
         if ((limit_flags & flags) && isConnected()) {
             return _rx_buffer.readline(!(limit_flags & DEV_IS_DATA), size);
@@ -1190,6 +1330,14 @@ struct xioDeviceWrapper : xioDeviceWrapperBase {    // describes a device for re
     };
 #endif
 
+    uint16_t linesQueued() override {
+        return _rx_buffer.linesQueued();
+    };
+
+    uint16_t lineSlots() override {
+        return _rx_buffer.lineSlots();
+    };
+
 };
 
 
@@ -1236,10 +1384,14 @@ struct xioFlashFileDeviceWrapper : xioDeviceWrapperBase {    // describes a devi
         return false;
     }
 
-    int16_t write(const char *buffer, int16_t len) final {
+    int16_t write(const char *buffer, int16_t len, xioTxPriority priority) final {
         return -1;
     }
 
+    uint16_t linesQueued() final {
+        return (nullptr == _current_file) ? 0 : 1;  // a file being sent always has more to come
+    }
+
     char *readline(devflags_t limit_flags, uint16_t &line_size) final {
         if (nullptr == _current_file) {
             line_size = 0;
@@ -1357,7 +1509,7 @@ stat_t xio_test_assertions()
 
 size_t xio_write(const char *buffer, size_t size, bool only_to_muted /*= false*/)
 {
-    return xio.write(buffer, size, only_to_muted);
+    return xio.write(buffer, size, only_to_muted, XIO_TX_RESPONSE);
 }
 
 /*
@@ -1372,9 +1524,31 @@ char *xio_readline(devflags_t &flags, uint16_t &size)
     return xio.readline(flags, size);
 }
 
-int16_t xio_writeline(const char *buffer, bool only_to_muted /*= false*/)
+int16_t xio_writeline(const char *buffer, bool only_to_muted /*= false*/, xioTxPriority priority /*= XIO_TX_RESPONSE*/)
+{
+    return xio.writeline(buffer, only_to_muted, priority);
+}
+
+/*
+ * xio_tx_callback()     - main loop callback to drain queued output to the devices
+ * xio_tx_backed_up()    - true if output is queued waiting for the host
+ * xio_tx_has_headroom() - true if there is room for a full response on every control channel
+ */
+
+stat_t xio_tx_callback()
+{
+    xio.drainTX();
+    return (STAT_OK);
+}
+
+bool xio_tx_backed_up()
+{
+    return xio.txBackedUp();
+}
+
+bool xio_tx_has_headroom()
 {
-    return xio.writeline(buffer, only_to_muted);
+    return xio.txHasHeadroom();
 }
 
 /*
@@ -1412,6 +1586,25 @@ void xio_exit_fake_bootloader() {
 }
 #endif
 
+/*
+ * xio_get_rx_lines_queued() - return # of received lines waiting to be read
+ *
+ *  Used for the Marlin advanced ok, and by the planner to tell streaming from MDI.
+ *  Lines are counted as the RX buffer is scanned by readline, so this can lag input.
+ */
+
+uint16_t xio_get_rx_lines_queued() {
+    return xio.linesQueued();
+}
+
+/*
+ * xio_get_rx_line_slots() - return # of full-length lines the RX buffers can hold (for Marlin advanced ok)
+ */
+
+uint16_t xio_get_rx_line_slots() {
+    return xio.lineSlots();
+}
+
 /***********************************************************************************
  * newlib-nano support functions
  * Here we wire printf to xio
@@ -107,6 +107,16 @@ enum xioSPIMode {
 };
 
 
+/**** TX queueing ****/
+
+#define XIO_TX_PENDING_SIZE  1024           // output held per device while the host is not reading
+#define XIO_TX_HEADROOM      512            // room kept for a full response (OUTPUT_BUFFER_LEN) before reading commands
+
+enum xioTxPriority {                        // how output is treated under backpressure
+    XIO_TX_REPORT = 0,                      // status and queue reports - dropped behind a backlog, regenerated later
+    XIO_TX_RESPONSE                         // responses and everything else - always queued, in order
+};
+
 /**** readline stuff *****/
 
 #define RX_BUFFER_SIZE       512            // maximum length of recieved lines from xio_readline
@@ -118,9 +128,14 @@ stat_t xio_test_assertions(void);
 
 size_t xio_write(const char *buffer, size_t size, bool only_to_muted = false);
 char *xio_readline(devflags_t &flags, uint16_t &size);
-int16_t xio_writeline(const char *buffer, bool only_to_muted = false);
+int16_t xio_writeline(const char *buffer, bool only_to_muted = false, xioTxPriority priority = XIO_TX_RESPONSE);
+stat_t xio_tx_callback(void);
+bool xio_tx_backed_up(void);
+bool xio_tx_has_headroom(void);
 bool xio_connected();
 void xio_flush_to_command();
+uint16_t xio_get_rx_lines_queued();
+uint16_t xio_get_rx_line_slots();
 #if MARLIN_COMPAT_ENABLED == true
 void xio_exit_fake_bootloader();
 #endif